@@ -1,6 +1,6 @@
 #!/bin/bash
 while [ 1 -gt 0 ]
 do
-    gcc -O3 -Wfatal-errors -lm -O3 -o ./main main.c && time ./main
+    gcc -O3 -fopenmp -Wfatal-errors -lm -O3 -o ./main main.c && time ./main
     read -p "Press enter to recompile and run"
 done
\ No newline at end of file
@@ -24,9 +24,9 @@ IF %ERRORLEVEL% NEQ 0 (
 :start
 title Compiling and Executing
 IF %USETIMEIT% NEQ 0 (
-	cl /nologo /DWIN32 /D_WINDOWS /W1 /MD /Ob0 /O2 /fp:fast main.c && echo. && timeit main.exe 0
+	cl /nologo /DWIN32 /D_WINDOWS /W1 /MD /Ob0 /O2 /fp:fast /openmp main.c && echo. && timeit main.exe 0
 ) else (
-	cl /nologo /DWIN32 /D_WINDOWS /W1 /MD /Ob0 /O2 /fp:fast main.c && echo. && main.exe 0
+	cl /nologo /DWIN32 /D_WINDOWS /W1 /MD /Ob0 /O2 /fp:fast /openmp main.c && echo. && main.exe 0
 )
 title Waiting for key to recompile
 echo.
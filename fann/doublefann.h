@@ -19,13 +19,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 // This is a header-only double fann fully functional library implementation
 // Slightly modified by Guilherme Rossato on 11/06/2020 to include RELU at fann_run and fann_activation_derived etc.
+// floatfann.h defines FLOATFANN and includes this same file, so there is a single copy of the implementation
 
 #ifndef SINGLE_FILE_FANN_H
 #define SINGLE_FILE_FANN_H
 
 // Define library types
-// #define FLOATFANN
+#ifndef FLOATFANN
 #define DOUBLEFANN
+#endif
 
 /* Version number of package */
 #define VERSION "2.3.1"
@@ -215,6 +217,7 @@ struct fann_error;
     FANN_E_INPUT_NO_MATCH - The number of input neurons in the ann and data don't match
     FANN_E_OUTPUT_NO_MATCH - The number of output neurons in the ann and data don't match
 	FANN_E_WRONG_PARAMETERS_FOR_CREATE - The parameters for create_standard are wrong, either too few parameters provided or a negative/very high value provided
+	FANN_E_CANT_USE_PRECISION - Unable to use the selected precision with this network
 */
 enum fann_errno_enum
 {
@@ -239,7 +242,8 @@ enum fann_errno_enum
 	FANN_E_SCALE_NOT_PRESENT,
 	FANN_E_INPUT_NO_MATCH,
 	FANN_E_OUTPUT_NO_MATCH,
-	FANN_E_WRONG_PARAMETERS_FOR_CREATE
+	FANN_E_WRONG_PARAMETERS_FOR_CREATE,
+	FANN_E_CANT_USE_PRECISION
 };
 
 /* Group: Error Handling */
@@ -332,9 +336,9 @@ FANN_EXTERNAL extern FILE * fann_default_error_log;
 /* defines used for the stepwise linear functions */
 
 /* Uses the single precision version of math.h functions if
-__doublefann_h__ is not defined
+DOUBLEFANN is not defined
 */
-#ifndef __doublefann_h__
+#ifndef DOUBLEFANN
 #define FANN_EXP(x) expf(x)
 #define FANN_SIN(x) sinf(x)
 #define FANN_COS(x) cosf(x)
@@ -477,6 +481,7 @@ switch(activation_function) \
 #define __fann_data_h__
 
 #include <stdio.h>
+#include <stdint.h>
 
 /* Section: FANN Datatypes
 
@@ -526,6 +531,25 @@ switch(activation_function) \
 		The quickprop training algorithm is described by [Fahlman, 1988].
 	FANN_TRAIN_SARPROP - THE SARPROP ALGORITHM: A SIMULATED ANNEALING ENHANCEMENT TO RESILIENT BACK PROPAGATION
     http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.47.8197&rep=rep1&type=pdf
+	FANN_TRAIN_MINIBATCH - Standard backpropagation algorithm, where the weights are updated after
+		each group of <fann_get_batch_size> training patterns with the mean of their slopes. The
+		patterns of a group are computed a layer at a time, so each weight is read once per group
+		instead of once per pattern. It lies between incremental and batch training: it updates
+		the weights many times per epoch, with a less noisy error than incremental training.
+	FANN_TRAIN_ADAM - Computes the slopes of groups of <fann_get_batch_size> patterns like
+		FANN_TRAIN_MINIBATCH, but each weight moves by the running mean of its slopes divided by
+		the square root of their running mean square, so every weight gets a step of about
+		learning_rate whatever the scale of its slope. With a weight decay it is the AdamW variant,
+		which shrinks the weights independently of their slopes. Adam usually needs a much smaller
+		learning rate than the other algorithms, such as 0.001. It is described by
+		[Kingma and Ba, 2014] and AdamW by [Loshchilov and Hutter, 2017].
+	FANN_TRAIN_HOGWILD - FANN_TRAIN_INCREMENTAL on <fann_get_num_threads> threads at once. Each
+		thread runs, backpropagates and updates the weights for every num_threads-th pattern on
+		its own copy of the neuron values and errors, but all of them update the same weights
+		without any lock, as described by [Niu et al., 2011]. A thread can read weights another
+		one is updating, or overwrite its update, which costs a little accuracy per epoch, so
+		unlike the other algorithms the result changes from run to run. With one thread, or
+		without OpenMP, it is exactly FANN_TRAIN_INCREMENTAL.
 
 	See also:
 		<fann_set_training_algorithm>, <fann_get_training_algorithm>
@@ -536,7 +560,10 @@ enum fann_train_enum
 	FANN_TRAIN_BATCH,
 	FANN_TRAIN_RPROP,
 	FANN_TRAIN_QUICKPROP,
-	FANN_TRAIN_SARPROP
+	FANN_TRAIN_SARPROP,
+	FANN_TRAIN_MINIBATCH,
+	FANN_TRAIN_ADAM,
+	FANN_TRAIN_HOGWILD
 };
 
 /* Constant: FANN_TRAIN_NAMES
@@ -555,7 +582,10 @@ static char const *const FANN_TRAIN_NAMES[] = {
 	"FANN_TRAIN_BATCH",
 	"FANN_TRAIN_RPROP",
 	"FANN_TRAIN_QUICKPROP",
-	"FANN_TRAIN_SARPROP"
+	"FANN_TRAIN_SARPROP",
+	"FANN_TRAIN_MINIBATCH",
+	"FANN_TRAIN_ADAM",
+	"FANN_TRAIN_HOGWILD"
 };
 
 /* Enums: fann_activationfunc_enum
@@ -826,6 +856,135 @@ static char const *const FANN_NETTYPE_NAMES[] = {
 	"FANN_NETTYPE_SHORTCUT"
 };
 
+/* Enum: fann_precision_enum
+
+	Precision of the weights and neuron values used by <fann_run>. Training always works
+	on fann_type, so a network can be trained in double and executed in float by the same binary.
+
+	FANN_PRECISION_DEFAULT - Execute with fann_type, exactly like the training functions do
+	FANN_PRECISION_FLOAT - Execute with a single precision copy of the weights, which halves
+		the memory read per connection and doubles the number of products per SIMD instruction
+	FANN_PRECISION_INT8 - Execute with int8 weights and neuron values, accumulated in int32.
+		Each neuron has its own weight scale and each layer has a value scale found by
+		<fann_calibrate_int8>, the bias weights and activation functions stay in float.
+		Only fully connected networks of type <FANN_NETTYPE_LAYER> can use it.
+	FANN_PRECISION_HALF - Execute like <FANN_PRECISION_FLOAT>, but with IEEE half precision
+		weights converted to float inside the dot product, by the F16C instructions when the
+		compiler targets them, which halves the memory read per connection again. Weights
+		beyond 65504 in absolute value become infinite.
+	FANN_PRECISION_BFLOAT16 - Execute like <FANN_PRECISION_HALF> with bfloat16 weights, the top
+		16 bits of a float, which keep the range of float but only 8 bits of precision.
+
+	See Also:
+		<fann_set_precision>, <fann_get_precision>
+*/
+enum fann_precision_enum
+{
+	FANN_PRECISION_DEFAULT = 0,
+	FANN_PRECISION_FLOAT,
+	FANN_PRECISION_INT8,
+	FANN_PRECISION_HALF,
+	FANN_PRECISION_BFLOAT16
+};
+
+/* Constant: FANN_PRECISION_NAMES
+
+   Constant array consisting of the names for the precisions, so that the name of a
+   precision can be received by:
+   (code)
+   char *precision_name = FANN_PRECISION_NAMES[fann_get_precision(ann)];
+   (end)
+
+   See Also:
+      <fann_precision_enum>
+*/
+static char const *const FANN_PRECISION_NAMES[] = {
+	"FANN_PRECISION_DEFAULT",
+	"FANN_PRECISION_FLOAT",
+	"FANN_PRECISION_INT8",
+	"FANN_PRECISION_HALF",
+	"FANN_PRECISION_BFLOAT16"
+};
+
+/* Enum: fann_approximation_enum
+
+	How the activation functions and their derivatives are computed, both by <fann_run>
+	and by the training functions.
+
+	FANN_APPROXIMATION_NONE - Compute each neuron on its own with the exp, sin and cos of math.h
+	FANN_APPROXIMATION_FAST - Compute a whole layer at a time with polynomial approximations of
+		exp, sin and cos, written so that the compiler can vectorize them. The relative error of
+		exp is below 2e-7, so the error of FANN_SIGMOID, FANN_SIGMOID_SYMMETRIC, FANN_GAUSSIAN and
+		FANN_GAUSSIAN_SYMMETRIC is below 4e-7, and the absolute error of sin and cos, used by
+		FANN_SIN, FANN_COS, FANN_SIN_SYMMETRIC and FANN_COS_SYMMETRIC and their derivatives,
+		is below 1e-7. The other activation functions are computed exactly.
+
+	See Also:
+		<fann_set_activation_approximation>, <fann_get_activation_approximation>
+*/
+enum fann_approximation_enum
+{
+	FANN_APPROXIMATION_NONE = 0,
+	FANN_APPROXIMATION_FAST
+};
+
+/* Constant: FANN_APPROXIMATION_NAMES
+
+   Constant array consisting of the names for the activation approximations, so that the name
+   of an approximation can be received by:
+   (code)
+   char *approximation_name = FANN_APPROXIMATION_NAMES[fann_get_activation_approximation(ann)];
+   (end)
+
+   See Also:
+      <fann_approximation_enum>
+*/
+static char const *const FANN_APPROXIMATION_NAMES[] = {
+	"FANN_APPROXIMATION_NONE",
+	"FANN_APPROXIMATION_FAST"
+};
+
+/* Enum: fann_pruning_schedule_enum
+
+	How the sparsity of a <struct fann_pruning_schedule> grows from its initial to its final
+	value between its first and last step. p is the fraction of that range that has passed.
+
+	FANN_PRUNING_LINEAR - The sparsity grows by the same amount every step:
+		initial + (final - initial) * p.
+	FANN_PRUNING_CUBIC - Gradual magnitude pruning [Zhu and Gupta, 2017]: the sparsity grows
+		fast at first, while the network has many redundant connections, and slowly at the end:
+		final + (initial - final) * (1 - p)^3.
+	FANN_PRUNING_EXPONENTIAL - The same share of the kept connections is pruned every step, so
+		the number of kept connections decays geometrically:
+		1 - (1 - initial) * ((1 - final) / (1 - initial))^p.
+
+	See Also:
+		<fann_get_scheduled_sparsity>, <fann_prune_on_schedule>
+*/
+enum fann_pruning_schedule_enum
+{
+	FANN_PRUNING_LINEAR = 0,
+	FANN_PRUNING_CUBIC,
+	FANN_PRUNING_EXPONENTIAL
+};
+
+/* Constant: FANN_PRUNING_SCHEDULE_NAMES
+
+   Constant array consisting of the names for the pruning schedules, so that the name of a
+   schedule can be received by:
+   (code)
+   char *schedule_name = FANN_PRUNING_SCHEDULE_NAMES[schedule.schedule];
+   (end)
+
+   See Also:
+      <fann_pruning_schedule_enum>
+*/
+static char const *const FANN_PRUNING_SCHEDULE_NAMES[] = {
+	"FANN_PRUNING_LINEAR",
+	"FANN_PRUNING_CUBIC",
+	"FANN_PRUNING_EXPONENTIAL"
+};
+
 
 /* forward declarations for use with the callback */
 struct fann;
@@ -869,11 +1028,36 @@ FANN_EXTERNAL typedef int (FANN_API * fann_callback_type) (
 	float error
 );
 
+/* Type: fann_pruning_callback_type
+   Called by <fann_prune_on_schedule> after every step it pruned the network, with the sparsity
+   the schedule asked for and the one the network reached, which is higher when more connections
+   were pruned before and lower when bias connections are kept. With layer_sparsity, the
+   scheduled sparsity is the one of each layer weighted by its number of connections.
+   user_data is the one of the <struct fann_pruning_schedule>.
+
+	>typedef void (FANN_API * fann_pruning_callback_type) (struct fann *ann, unsigned int step,
+	>													  float scheduled_sparsity, float sparsity,
+	>													  void *user_data);
+
+	See also:
+		<fann_prune_on_schedule>
+ */
+FANN_EXTERNAL typedef void (FANN_API * fann_pruning_callback_type) (
+	struct fann *ann,
+	unsigned int step,
+	float scheduled_sparsity,
+	float sparsity,
+	void *user_data
+);
+
 
 /* ----- Data structures -----
  * No data within these structures should be altered directly by the user.
  */
 
+/* The sum and value of the neurons are not stored here but in the sums and values
+ * arrays of struct fann, so the forward and backward passes read them contiguously.
+ */
 struct fann_neuron
 {
 	/* Index to the first and last connection
@@ -881,19 +1065,11 @@ struct fann_neuron
 	 */
 	unsigned int first_con;
 	unsigned int last_con;
-	/* The sum of the inputs multiplied with the weights */
-	fann_type sum;
-	/* The value of the activation function applied to the sum */
-	fann_type value;
 	/* The steepness of the activation function */
 	fann_type activation_steepness;
 	/* Used to choose which activation function to use */
 	enum fann_activationfunc_enum activation_function;
-#ifdef __GNUC__
-} __attribute__ ((packed));
-#else
 };
-#endif
 
 /* A single layer in the neural network.
  */
@@ -983,6 +1159,16 @@ struct fann
 	 */
 	unsigned int total_neurons;
 
+	/* The value of the activation function applied to the sum of each neuron,
+	 * in the same order as the neurons, so the values of a layer are contiguous
+	 */
+	fann_type *values;
+
+	/* The sum of the inputs multiplied with the weights of each neuron,
+	 * in the same order as the neurons
+	 */
+	fann_type *sums;
+
 	/* Number of input neurons (not calculating bias) */
 	unsigned int num_input;
 
@@ -992,6 +1178,13 @@ struct fann
 	/* The weight array */
 	fann_type *weights;
 
+	/* The mapping of the file weights points into when the network was loaded by
+	 * fann_create_from_binary, NULL when weights is allocated.
+	 * The mapping is private, so changing the weights does not change the file.
+	 */
+	void *weights_mapping;
+	size_t weights_mapping_size;
+
 	/* The connection array */
 	struct fann_neuron **connections;
 
@@ -1207,6 +1400,21 @@ struct fann
 	/* Current training epoch */
 	unsigned int sarprop_epoch;
 
+	/* Decay rate of the running mean of the slopes used by Adam */
+	float adam_beta1;
+
+	/* Decay rate of the running mean of the squared slopes used by Adam */
+	float adam_beta2;
+
+	/* Added to the root of the mean squared slope so Adam never divides by zero */
+	float adam_epsilon;
+
+	/* Fraction of each weight removed by every AdamW update, times the learning rate */
+	float adam_weight_decay;
+
+	/* Number of Adam updates since the train arrays were cleared */
+	unsigned int adam_timestep;
+
 	/* Used to contain the slope errors used during batch training
 	 * Is allocated during first training session,
 	 * which means that if we do not train, it is never allocated.
@@ -1229,6 +1437,99 @@ struct fann
 	 */
 	fann_type *prev_weights_deltas;
 
+	/* The precision used by fann_run (default FANN_PRECISION_DEFAULT) */
+	enum fann_precision_enum precision;
+
+	/* How the activation functions are computed (default FANN_APPROXIMATION_NONE) */
+	enum fann_approximation_enum activation_approximation;
+
+	/* Single precision copy of the weights, used when precision is FANN_PRECISION_FLOAT.
+	 * Not allocated if not used.
+	 */
+	float *weights_float;
+
+	/* Single precision neuron values, one per neuron in the same order as the neurons,
+	 * so each layer is a contiguous input to the next one.
+	 * Not allocated if not used.
+	 */
+	float *values_float;
+
+	/* Half precision or bfloat16 copy of the weights, indexed like the weights, used when
+	 * precision is FANN_PRECISION_HALF or FANN_PRECISION_BFLOAT16 with values_float.
+	 * Not allocated if not used.
+	 */
+	uint16_t *weights_half;
+
+	/* Int8 copy of the weights, indexed like the weights, used when precision is
+	 * FANN_PRECISION_INT8. The bias connections are not quantized.
+	 * Not allocated if not used.
+	 */
+	signed char *weights_int8;
+
+	/* The scale of the int8 weights of each neuron, weight = weights_int8 * scale.
+	 * Not allocated if not used.
+	 */
+	float *weights_int8_scale;
+
+	/* Int8 neuron values, one per neuron in the same order as the neurons.
+	 * Not allocated if not used.
+	 */
+	signed char *values_int8;
+
+	/* The scale of the int8 neuron values of each layer, value = values_int8 * scale.
+	 * Allocated by fann_calibrate_int8.
+	 */
+	float *values_int8_scale;
+
+	/* Is 1 when the weights changed after the precision copies were last converted */
+	unsigned int precision_stale;
+
+	/* The number of threads used by the batch and hogwild training epochs, 0 for one per core (default 0) */
+	unsigned int num_threads;
+
+	/* Copies of this network used by the other threads of a parallel epoch. They share the
+	 * weights and the neurons with this network, but have their own values, sums, output,
+	 * train_errors and train_slopes.
+	 * Not allocated if not used.
+	 */
+	struct fann *parallel_workers;
+
+	/* The number of parallel_workers */
+	unsigned int num_parallel_workers;
+
+	/* The number of training patterns per weight update of FANN_TRAIN_MINIBATCH and
+	 * FANN_TRAIN_ADAM (default 32) */
+	unsigned int batch_size;
+
+	/* The values, sums and train_errors of the patterns of a mini-batch, total_neurons
+	 * per pattern, one pattern after the other.
+	 * Not allocated if not used.
+	 */
+	fann_type *batch_values;
+	fann_type *batch_sums;
+	fann_type *batch_errors;
+
+	/* The number of fann_type allocated in each of batch_values, batch_sums and batch_errors */
+	unsigned int batch_buffer_size;
+
+	/* 1 for each connection that is kept and 0 for each pruned one, indexed like the weights.
+	 * The weight updates are multiplied by it, so the pruned weights stay 0.
+	 * Not allocated if no connection was pruned.
+	 */
+	fann_type *connection_mask;
+
+	/* The number of connections kept by connection_mask */
+	unsigned int total_active_connections;
+
+	/* The kept connections of each neuron as offsets from its first_con, one neuron after
+	 * the other: neuron n keeps active_offsets[active_first[n]] to active_offsets[active_first[n + 1] - 1].
+	 * When few enough connections are kept, training and fann_run go through these
+	 * instead of through all the connections.
+	 * Not allocated if not used.
+	 */
+	unsigned int *active_offsets;
+	unsigned int *active_first;
+
 #ifndef FIXEDFANN
 	/* Arithmetic mean used to remove steady component in input data.  */
 	float *scale_mean_in;
@@ -1287,6 +1588,48 @@ struct fann_connection
     fann_type weight;
 };
 
+/* Struct: struct fann_pruning_schedule
+
+	Describes how much of a network <fann_prune_on_schedule> prunes at each step of a training
+	loop. Unlike the other structures its fields are meant to be set directly, after
+	<fann_init_pruning_schedule> has set them all to their defaults.
+
+	schedule - How the sparsity grows, one of <fann_pruning_schedule_enum>
+	first_step - The step the sparsity starts growing from initial_sparsity
+	last_step - The step the sparsity reaches final_sparsity
+	frequency - The network is pruned every frequency steps from first_step on, and at last_step
+	initial_sparsity - The sparsity at first_step (default 0)
+	final_sparsity - The sparsity at last_step
+	layer_sparsity - NULL to prune the smallest weights of the whole network, or the final
+		sparsity of each layer, from the connections into the first hidden layer to those into
+		the output layer, which then follow the curve on their own (default NULL)
+	keep_bias - When not 0, the connections from the bias neurons are never pruned and do not
+		count in the sparsity of their layer (default 0)
+	rewind_weights - NULL to keep training the pruned network from its trained weights, or
+		<fann_get_total_connections> weights the kept connections are rewound to with
+		<fann_rewind_weights> each time connections are pruned, usually the ones the network
+		had after <fann_randomize_weights> or after its first steps (default NULL)
+	callback - Called after each pruning, NULL for none (default NULL)
+	user_data - Passed to callback (default NULL)
+
+	See Also:
+		<fann_init_pruning_schedule>, <fann_prune_on_schedule>
+*/
+struct fann_pruning_schedule
+{
+	enum fann_pruning_schedule_enum schedule;
+	unsigned int first_step;
+	unsigned int last_step;
+	unsigned int frequency;
+	float initial_sparsity;
+	float final_sparsity;
+	const float *layer_sparsity;
+	int keep_bias;
+	const fann_type *rewind_weights;
+	fann_pruning_callback_type callback;
+	void *user_data;
+};
+
 #endif
 
 
@@ -1298,6 +1641,7 @@ struct fann_connection
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #define FANN_FIX_VERSION "FANN_FIX_2.0"
 #define FANN_FLO_VERSION "FANN_FLO_2.1"
@@ -1326,6 +1670,7 @@ FANN_SET(type, name)
 
 
 struct fann_train_data;
+struct fann_sum_cache;
 
 struct fann *fann_allocate_structure(unsigned int num_layers);
 void fann_allocate_neurons(struct fann *ann);
@@ -1335,7 +1680,7 @@ void fann_allocate_connections(struct fann *ann);
 int fann_save_internal(struct fann *ann, const char *configuration_file,
 					   unsigned int save_as_fixed);
 int fann_save_internal_fd(struct fann *ann, FILE * conf, const char *configuration_file,
-						  unsigned int save_as_fixed);
+						  unsigned int save_as_fixed, unsigned int save_connections);
 int fann_save_train_internal(struct fann_train_data *data, const char *filename,
 							  unsigned int save_as_fixed, unsigned int decimal_point);
 int fann_save_train_internal_fd(struct fann_train_data *data, FILE * file, const char *filename,
@@ -1347,7 +1692,39 @@ void fann_seed_rand();
 void fann_error(struct fann_error *errdat, const enum fann_errno_enum errno_f, ...);
 void fann_init_error_data(struct fann_error *errdat);
 
-struct fann *fann_create_from_fd(FILE * conf, const char *configuration_file);
+struct fann *fann_create_from_fd(FILE * conf, const char *configuration_file,
+								 unsigned int read_connections);
+void fann_free_weights(struct fann *ann);
+int fann_unmap_weights(struct fann *ann);
+int fann_is_little_endian(void);
+void fann_swap_bytes(void *array, size_t element_size, size_t count);
+void fann_write_le(unsigned char *buffer, uint64_t value, unsigned int size);
+uint64_t fann_read_le(const unsigned char *buffer, unsigned int size);
+int fann_write_le_array(FILE *file, const void *array, size_t element_size, size_t count);
+int fann_write_binary_padding(FILE *file, long *offset);
+int fann_write_varint(FILE *file, unsigned int value);
+int fann_read_varint(const unsigned char **position, const unsigned char *end, unsigned int *value);
+FILE *fann_open_temporary_file(struct fann_error *errdat, const char *configuration_file, const char *mode,
+							   char **temporary_file);
+int fann_replace_file(struct fann_error *errdat, FILE *file, char *temporary_file,
+					  const char *configuration_file, int retval);
+#ifndef FIXEDFANN
+int fann_write_sparse_connections(struct fann *ann, FILE *file);
+int fann_read_sparse_connections(struct fann *ann, const unsigned char *buffer, size_t size,
+								 unsigned int num_kept);
+int fann_write_binary_weights(FILE *file, const fann_type *weights, const fann_type *mask,
+							  unsigned int count, enum fann_precision_enum precision);
+unsigned int fann_read_binary_weights(FILE *file, fann_type *weights, unsigned int count,
+									  unsigned int weight_size, unsigned int bfloat16);
+int fann_save_binary_fd(struct fann *ann, FILE *file, const char *configuration_file,
+						enum fann_precision_enum precision);
+struct fann *fann_create_from_binary_fd(FILE *file, const char *configuration_file);
+int fann_save_checkpoint_internal_fd(struct fann *ann, FILE *file, const char *configuration_file);
+void fann_save_checkpoint_array(FILE *file, const char *name, const fann_type *array, unsigned int count);
+struct fann *fann_create_from_checkpoint_internal_fd(FILE *file, const char *configuration_file);
+int fann_read_checkpoint_array(struct fann *ann, FILE *file, const char *configuration_file,
+							   const char *name, fann_type **array);
+#endif
 struct fann_train_data *fann_read_train_from_fd(FILE * file, const char *filename);
 
 void fann_compute_MSE(struct fann *ann, fann_type * desired_output);
@@ -1364,8 +1741,61 @@ void fann_update_weights_irpropm(struct fann *ann, unsigned int first_weight,
 								 unsigned int past_end);
 void fann_update_weights_sarprop(struct fann *ann, unsigned int epoch, unsigned int first_weight,
 								unsigned int past_end);
+void fann_update_weights_adam(struct fann *ann, unsigned int num_data, unsigned int first_weight,
+							  unsigned int past_end);
 
 void fann_clear_train_arrays(struct fann *ann);
+void fann_compute_epoch_slopes(struct fann *ann, struct fann_train_data *data);
+int fann_prepare_parallel_workers(struct fann *ann, unsigned int num_workers);
+void fann_destroy_parallel_workers(struct fann *ann);
+void fann_compute_batch_slopes(struct fann *ann, struct fann_train_data *data,
+							   unsigned int first_data, unsigned int num_data);
+
+int fann_allocate_connection_mask(struct fann *ann);
+int fann_update_active_connections(struct fann *ann);
+void fann_apply_connection_mask(struct fann *ann, unsigned int first_weight, unsigned int past_end);
+uint64_t fann_magnitude_key(fann_type weight);
+uint64_t fann_select_key(uint64_t *keys, int count, int rank);
+int fann_prune_smallest_in_range(struct fann *ann, unsigned int first_con, unsigned int past_con,
+								 float sparsity, const unsigned char *exempt_neurons);
+unsigned char *fann_create_bias_flags(struct fann *ann);
+
+int fann_convert_precision_weights(struct fann *ann);
+int fann_convert_weights_float(struct fann *ann);
+int fann_convert_weights_int8(struct fann *ann);
+int fann_convert_weights_half(struct fann *ann);
+fann_type *fann_run_float(struct fann *ann, fann_type * input);
+fann_type *fann_run_int8(struct fann *ann, fann_type * input);
+fann_type fann_dot(const fann_type *a, const fann_type *b, unsigned int n);
+void fann_axpy(fann_type *y, fann_type alpha, const fann_type *x, unsigned int n);
+void fann_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+						fann_type momentum, unsigned int n);
+void fann_sqrt8(fann_type *lanes);
+void fann_masked_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+							   fann_type momentum, const fann_type *mask, unsigned int n);
+fann_type fann_sparse_dot(const fann_type *a, const fann_type *b, const unsigned int *offsets,
+						  unsigned int n);
+void fann_sparse_axpy(fann_type *y, fann_type alpha, const fann_type *x, const unsigned int *offsets,
+					  unsigned int n);
+void fann_sparse_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+							   fann_type momentum, const unsigned int *offsets, unsigned int n);
+float fann_dot_float(const float *a, const float *b, unsigned int n);
+float fann_dot_half(const uint16_t *a, const float *b, unsigned int n);
+float fann_dot_bfloat16(const uint16_t *a, const float *b, unsigned int n);
+uint16_t fann_float_to_half(float value);
+float fann_half_to_float(uint16_t half);
+void fann_half_to_float_array(const uint16_t *half, float *values, unsigned int n);
+uint16_t fann_float_to_bfloat16(float value);
+float fann_bfloat16_to_float(uint16_t bfloat16);
+int fann_dot_int8(const signed char *a, const signed char *b, unsigned int n);
+signed char fann_quantize_int8(float value);
+fann_type fann_exp_approx(fann_type x);
+fann_type fann_sin_approx(fann_type x);
+void fann_activate_layer(struct fann *ann, struct fann_neuron *first_neuron, struct fann_neuron *last_neuron);
+void fann_run_layers(struct fann *ann, struct fann_layer *first_layer);
+void fann_compute_cached_sums(struct fann *ann, struct fann_sum_cache *cache);
+void fann_activation_derived_layer(struct fann *ann, const struct fann_neuron *first_neuron,
+								   const struct fann_neuron *last_neuron, fann_type *errors);
 
 fann_type fann_activation(struct fann * ann, unsigned int activation_function, fann_type steepness,
 						  fann_type value);
@@ -1639,6 +2069,90 @@ FANN_EXTERNAL float FANN_API fann_train_epoch(struct fann *ann, struct fann_trai
  */
 FANN_EXTERNAL float FANN_API fann_test_data(struct fann *ann, struct fann_train_data *data);
 
+#ifndef FIXEDFANN
+/* Struct: struct fann_sum_cache
+	The sums of the neurons of the first hidden layer for every pattern of a
+	<struct fann_train_data>, and the weights they were computed with. In a network with many
+	inputs the connections into the first hidden layer are almost all of them, so once the sums
+	are cached a pattern is run again through the few connections of the later layers only.
+
+	The fields are only meant to be read. The cache is created by <fann_create_sum_cache> and
+	freed by <fann_destroy_sum_cache>.
+
+	data - The patterns, which must outlive the cache
+	first_neuron - The index of the first neuron of the first hidden layer
+	num_neurons - The number of neurons of the first hidden layer, bias neuron included
+	first_con - The index of the first connection into the first hidden layer
+	num_connections - The number of connections into the first hidden layer
+	sums - num_neurons sums per pattern, before the activation steepness is applied
+	weights - The num_connections weights the sums are up to date with
+
+	See also:
+		<fann_create_sum_cache>, <fann_update_sum_cache>, <fann_run_sum_cache>
+*/
+struct fann_sum_cache
+{
+	struct fann_train_data *data;
+	unsigned int first_neuron;
+	unsigned int num_neurons;
+	unsigned int first_con;
+	unsigned int num_connections;
+	fann_type *sums;
+	fann_type *weights;
+};
+
+/* Function: fann_create_sum_cache
+	Runs every pattern of *data* through the connections into the first hidden layer of *ann*
+	and caches the sums of its neurons, to run the patterns again with <fann_run_sum_cache>
+	after the weights changed. With OpenMP the patterns are split across
+	<fann_get_num_threads> threads.
+
+	Returns the cache, or NULL if it could not be allocated or the inputs of *data* do not match
+	the network.
+
+	See also:
+		<fann_update_sum_cache>, <fann_destroy_sum_cache>
+*/
+FANN_EXTERNAL struct fann_sum_cache *FANN_API fann_create_sum_cache(struct fann *ann,
+																	struct fann_train_data *data);
+
+/* Function: fann_update_sum_cache
+	Brings the sums of *cache* up to date with the weights of *ann*. Each connection into the
+	first hidden layer whose weight changed since the last update adds the change times its
+	input to the sum of its neuron in every pattern, so pruning k connections costs k
+	multiplications per pattern instead of a full run. When more than half the connections
+	changed, as after training, the sums are computed again from scratch instead.
+
+	Sums updated this way can differ from those of <fann_run> by rounding.
+
+	Returns the number of connections whose weight changed.
+
+	See also:
+		<fann_create_sum_cache>, <fann_run_sum_cache>
+*/
+FANN_EXTERNAL unsigned int FANN_API fann_update_sum_cache(struct fann *ann, struct fann_sum_cache *cache);
+
+/* Function: fann_run_sum_cache
+	Runs pattern number *pattern* of the data of *cache* like <fann_run>, but starting from its
+	cached sums of the first hidden layer, which <fann_update_sum_cache> must have brought up
+	to date with the weights. The network is run in fann_type whatever its
+	<fann_get_precision>, and the neuron values and output are left in *ann* as <fann_run>
+	leaves them.
+
+	Returns the output of the network, or NULL if *pattern* is out of range.
+
+	See also:
+		<fann_create_sum_cache>, <fann_update_sum_cache>
+*/
+FANN_EXTERNAL fann_type *FANN_API fann_run_sum_cache(struct fann *ann, struct fann_sum_cache *cache,
+													 unsigned int pattern);
+
+/* Function: fann_destroy_sum_cache
+	Frees a cache created by <fann_create_sum_cache>. The data it caches the sums of is not freed.
+*/
+FANN_EXTERNAL void FANN_API fann_destroy_sum_cache(struct fann_sum_cache *cache);
+#endif	/* NOT FIXEDFANN */
+
 /* Group: Training Data Manipulation */
 
 /* Function: fann_read_train_from_file
@@ -2184,12 +2698,69 @@ FANN_EXTERNAL void FANN_API fann_set_training_algorithm(struct fann *ann,
 														enum fann_train_enum training_algorithm);
 
 
+/* Function: fann_get_num_threads
+
+   Return the number of threads used by the FANN_TRAIN_BATCH, FANN_TRAIN_RPROP,
+   FANN_TRAIN_QUICKPROP, FANN_TRAIN_SARPROP and FANN_TRAIN_HOGWILD epochs.
+
+   The training patterns of a batch epoch are split in one contiguous chunk per thread, and the
+   slopes of the chunks are added in a fixed order, so training gives the same result every
+   time for the same number of threads. FANN_TRAIN_HOGWILD does not, as described in
+   <fann_train_enum>. 0 means one thread per available core.
+
+   The threads are only used when the library is compiled with OpenMP (-fopenmp with gcc)
+   and DISABLE_PARALLEL_FANN is not defined, and while the precision is
+   FANN_PRECISION_DEFAULT. Otherwise the epochs run on the calling thread.
+
+   The default number of threads is 0.
+
+   See also:
+    <fann_set_num_threads>, <fann_set_training_algorithm>
+ */
+FANN_EXTERNAL unsigned int FANN_API fann_get_num_threads(struct fann *ann);
+
+
+/* Function: fann_set_num_threads
+
+   Set the number of threads used by the batch and FANN_TRAIN_HOGWILD training epochs.
+
+   More info available in <fann_get_num_threads>
+ */
+FANN_EXTERNAL void FANN_API fann_set_num_threads(struct fann *ann, unsigned int num_threads);
+
+
+/* Function: fann_get_batch_size
+
+   Return the number of training patterns between two weight updates of FANN_TRAIN_MINIBATCH
+   and FANN_TRAIN_ADAM.
+   The last group of an epoch is smaller when the number of patterns is not a multiple of it,
+   and a batch size of 0 is used as 1.
+
+   The default batch size is 32. The batch size is not saved by <fann_save>.
+
+   See also:
+    <fann_set_batch_size>, <fann_train_enum>
+ */
+FANN_EXTERNAL unsigned int FANN_API fann_get_batch_size(struct fann *ann);
+
+
+/* Function: fann_set_batch_size
+
+   Set the number of training patterns between two weight updates of FANN_TRAIN_MINIBATCH
+   and FANN_TRAIN_ADAM.
+
+   More info available in <fann_get_batch_size>
+ */
+FANN_EXTERNAL void FANN_API fann_set_batch_size(struct fann *ann, unsigned int batch_size);
+
+
 /* Function: fann_get_learning_rate
 
    Return the learning rate.
 
    The learning rate is used to determine how aggressive training should be for some of the
-   training algorithms (FANN_TRAIN_INCREMENTAL, FANN_TRAIN_BATCH, FANN_TRAIN_QUICKPROP).
+   training algorithms (FANN_TRAIN_INCREMENTAL, FANN_TRAIN_BATCH, FANN_TRAIN_QUICKPROP,
+   FANN_TRAIN_MINIBATCH, FANN_TRAIN_ADAM, FANN_TRAIN_HOGWILD).
    Do however note that it is not used in FANN_TRAIN_RPROP.
 
    The default learning rate is 0.7.
@@ -2216,7 +2787,8 @@ FANN_EXTERNAL void FANN_API fann_set_learning_rate(struct fann *ann, float learn
 
    Get the learning momentum.
 
-   The learning momentum can be used to speed up FANN_TRAIN_INCREMENTAL training.
+   The learning momentum can be used to speed up FANN_TRAIN_INCREMENTAL and FANN_TRAIN_HOGWILD
+   training.
    A too high momentum will however not benefit training. Setting momentum to 0 will
    be the same as not using the momentum parameter. The recommended value of this parameter
    is between 0.0 and 1.0.
@@ -2443,6 +3015,29 @@ FANN_EXTERNAL void FANN_API fann_set_activation_steepness_output(struct fann *an
 																 fann_type steepness);
 
 
+/* Function: fann_get_activation_approximation
+
+   Return how the activation functions and their derivatives are computed, as described
+   by <fann_approximation_enum>.
+
+   The default is FANN_APPROXIMATION_NONE. The approximation is not saved by <fann_save>.
+
+   See also:
+   	<fann_set_activation_approximation>, <fann_approximation_enum>
+ */
+FANN_EXTERNAL enum fann_approximation_enum FANN_API fann_get_activation_approximation(struct fann *ann);
+
+
+/* Function: fann_set_activation_approximation
+
+   Set how the activation functions and their derivatives are computed.
+
+   More info available in <fann_get_activation_approximation>
+ */
+FANN_EXTERNAL void FANN_API fann_set_activation_approximation(struct fann *ann,
+															   enum fann_approximation_enum activation_approximation);
+
+
 /* Function: fann_get_train_error_function
 
    Returns the error function used during training.
@@ -2834,6 +3429,89 @@ FANN_EXTERNAL float FANN_API fann_get_sarprop_temperature(struct fann *ann);
    */
 FANN_EXTERNAL void FANN_API fann_set_sarprop_temperature(struct fann *ann, float sarprop_temperature);
 
+/* Method: fann_get_adam_beta1
+
+   The decay rate of the running mean of the slopes used by FANN_TRAIN_ADAM.
+
+   The default beta1 is 0.9. The Adam parameters are not saved by <fann_save>.
+
+   See also:
+   <fann_set_adam_beta1>, <fann_get_adam_beta2>
+   */
+FANN_EXTERNAL float FANN_API fann_get_adam_beta1(struct fann *ann);
+
+/* Method: fann_set_adam_beta1
+
+   Set the adam beta1.
+
+   See also:
+   <fann_get_adam_beta1>
+   */
+FANN_EXTERNAL void FANN_API fann_set_adam_beta1(struct fann *ann, float adam_beta1);
+
+/* Method: fann_get_adam_beta2
+
+   The decay rate of the running mean of the squared slopes used by FANN_TRAIN_ADAM.
+
+   The default beta2 is 0.999.
+
+   See also:
+   <fann_set_adam_beta2>, <fann_get_adam_beta1>
+   */
+FANN_EXTERNAL float FANN_API fann_get_adam_beta2(struct fann *ann);
+
+/* Method: fann_set_adam_beta2
+
+   Set the adam beta2.
+
+   See also:
+   <fann_get_adam_beta2>
+   */
+FANN_EXTERNAL void FANN_API fann_set_adam_beta2(struct fann *ann, float adam_beta2);
+
+/* Method: fann_get_adam_epsilon
+
+   The value added to the root of the mean squared slope by FANN_TRAIN_ADAM, so weights
+   whose slope is always zero do not divide by zero.
+
+   The default epsilon is 1e-8.
+
+   See also:
+   <fann_set_adam_epsilon>
+   */
+FANN_EXTERNAL float FANN_API fann_get_adam_epsilon(struct fann *ann);
+
+/* Method: fann_set_adam_epsilon
+
+   Set the adam epsilon.
+
+   See also:
+   <fann_get_adam_epsilon>
+   */
+FANN_EXTERNAL void FANN_API fann_set_adam_epsilon(struct fann *ann, float adam_epsilon);
+
+/* Method: fann_get_adam_weight_decay
+
+   The decoupled weight decay of FANN_TRAIN_ADAM: every update multiplies all the weights,
+   the bias weights included, by 1 - learning_rate * weight_decay. A value above 0 turns
+   Adam into AdamW.
+
+   The default weight decay is 0.
+
+   See also:
+   <fann_set_adam_weight_decay>
+   */
+FANN_EXTERNAL float FANN_API fann_get_adam_weight_decay(struct fann *ann);
+
+/* Method: fann_set_adam_weight_decay
+
+   Set the adam weight decay.
+
+   See also:
+   <fann_get_adam_weight_decay>
+   */
+FANN_EXTERNAL void FANN_API fann_set_adam_weight_decay(struct fann *ann, float adam_weight_decay);
+
 #endif
 
 
@@ -2881,6 +3559,9 @@ FANN_EXTERNAL void FANN_API fann_set_sarprop_temperature(struct fann *ann, float
 	Instead of printing out reports every neurons_between_reports, a callback function can be called
 	(see <fann_set_callback>).
 
+	The connections pruned by <fann_prune_connections> are kept again, with a weight of 0, since
+	the new neurons change the connections of the network.
+
 	See also:
 		<fann_train_on_data>, <fann_cascadetrain_on_file>, <Parameters>
 
@@ -3461,42 +4142,244 @@ FANN_EXTERNAL int FANN_API fann_save(struct fann *ann, const char *configuration
 */
 FANN_EXTERNAL int FANN_API fann_save_to_fixed(struct fann *ann, const char *configuration_file);
 
-#endif
+#ifndef FIXEDFANN
 
+/* Function: fann_save_binary
+
+   Saves the network like <fann_save>, but in a binary file that <fann_create_from_binary> loads
+   without parsing the connections. The file starts with a 64 byte header:
+
+   >offset size
+   >0      8    "FANN_BIN"
+   >8      4    format version, 2
+   >12     2    bytes per weight, sizeof(fann_type) unless saved with another precision
+   >14     2    1 when the weights are bfloat16, 0 otherwise
+   >16     8    offset of the parameters
+   >24     8    size of the parameters
+   >32     8    offset of the connections
+   >40     8    offset of the weights
+   >48     4    number of connections
+   >52     4    number of connections kept by the pruning
+   >56     8    size of the file
+
+   The offsets are from the start of the header. In a bundle saved by <fann_save_bundle> the
+   header is where the network starts in the bundle, and its last field is the size of the
+   network.
+
+   The parameters are the text <fann_save> writes up to the neurons. The connections are the
+   index of the neuron each connection comes from, as 4 byte integers, and the weights follow
+   as fann_type values. Every number is little-endian and every section starts at a multiple
+   of 64 bytes, so the weights can be used in place once the file is mapped in memory.
+
+   When connections were pruned, they are saved in a sparse encoding instead. The connections
+   are, for each neuron, its number of runs of consecutive source neurons followed by the first
+   source and the length of each run, then, for each kept connection, the number of pruned
+   connections before it since the previous kept one. These numbers are written 7 bits per
+   byte, the high bit telling whether more bytes follow. The weights are those of the kept
+   connections only. <fann_create_from_binary> restores the pruning from them, so a network
+   degraded to 85 % sparsity takes about a seventh of the space and runs through its kept
+   connections as soon as it is loaded.
+
+   Files of version 1, where the number of connections and the bytes per weight take 8 and
+   4 bytes and no connection is pruned, are still loaded.
+
+   Like <fann_save>, the precision set by <fann_set_precision> and the training state are not
+   saved.
+
+   The network is written to configuration_file with ".tmp" appended, which is then renamed
+   over configuration_file, so a network loaded from a file can be saved back to it while its
+   weights are still mapped from the previous one.
 
-/* Function: fann_create_standard
+   Return:
+   The function returns 0 on success and -1 on failure.
 
-	Creates a standard fully connected backpropagation neural network.
+   See also:
+    <fann_save_binary_with_precision>, <fann_create_from_binary>, <fann_save>
+ */
+FANN_EXTERNAL int FANN_API fann_save_binary(struct fann *ann, const char *configuration_file);
 
-	There will be a bias neuron in each layer (except the output layer),
-	and this bias neuron will be connected to all neurons in the next layer.
-	When running the network, the bias nodes always emits 1.
+/* Function: fann_save_binary_with_precision
 
-	To destroy a <struct fann> use the <fann_destroy> function.
+   Saves the network like <fann_save_binary>, with its weights rounded to the precision of
+   the weights of <fann_run> for that precision: float for <FANN_PRECISION_FLOAT>, IEEE half
+   precision for <FANN_PRECISION_HALF> and bfloat16 for <FANN_PRECISION_BFLOAT16>, which take
+   half and a quarter of the space of double weights. <FANN_PRECISION_DEFAULT> saves fann_type
+   like <fann_save_binary>, and <FANN_PRECISION_INT8> can not be used.
 
-	Parameters:
-		num_layers - The total number of layers including the input and the output layer.
-		... - Integer values determining the number of neurons in each layer starting with the
-			input layer and ending with the output layer.
+   <fann_create_from_binary> converts the weights back to fann_type, so the network runs and
+   trains as usual. Setting the same precision with <fann_set_precision> afterwards runs it on
+   exactly the saved weights, with the memory of the smaller ones.
 
-	Returns:
-		A pointer to the newly created <struct fann>.
+   Return:
+   The function returns 0 on success and -1 on failure.
 
-	Example:
-		> // Creating an ANN with 2 input neurons, 1 output neuron,
-		> // and two hidden layers with 8 and 9 neurons
-		> struct fann *ann = fann_create_standard(4, 2, 8, 9, 1);
+   See also:
+    <fann_save_binary>, <fann_set_precision>
+ */
+FANN_EXTERNAL int FANN_API fann_save_binary_with_precision(struct fann *ann, const char *configuration_file,
+														   enum fann_precision_enum precision);
 
-	See also:
-		<fann_create_standard_array>, <fann_create_sparse>, <fann_create_shortcut>
+/* Function: fann_create_from_binary
 
-	This function appears in FANN >= 2.0.0.
-*/
-FANN_EXTERNAL struct fann *FANN_API fann_create_standard(unsigned int num_layers, ...);
+   Constructs a network from a file saved by <fann_save_binary>. Where mmap is available and
+   the file has the byte order and weight size of this build, the file is mapped privately and
+   the weights are used where they are, so loading does not read them at all: the pages are
+   read the first time <fann_run> goes through them, and changing the weights, by training
+   for instance, copies the changed pages instead of writing to the file. Otherwise the
+   weights are read and converted, from float, double, half precision or bfloat16, into
+   allocated memory, the half precision ones eight at a time with F16C. The weights
+   of a pruned network are always read, and put back at their connections.
 
-/* Function: fann_create_standard_array
-   Just like <fann_create_standard>, but with an array of layer sizes
-   instead of individual parameters.
+   See also:
+    <fann_save_binary>, <fann_create_from_file>
+ */
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_binary(const char *configuration_file);
+
+/* Function: fann_save_bundle
+
+   Saves several networks, and a text describing them, in one binary file, so they can be
+   loaded together with <fann_create_from_bundle>. The file starts with a 64 byte header:
+
+   >offset size
+   >0      8    "FANN_BDL"
+   >8      4    format version, 1
+   >12     4    number of networks
+   >16     8    offset of the metadata
+   >24     8    size of the metadata
+   >32     8    offset of the table of networks
+   >40     8    size of the file
+
+   The table holds the offset of every network as an 8 byte little-endian integer, and is
+   followed by the metadata. Each network is then written as <fann_save_binary> writes it,
+   starting at a multiple of 64 bytes. The metadata is kept as it is, without its terminating
+   zero, and can be NULL. The weights are saved with precision, like
+   <fann_save_binary_with_precision> does.
+
+   The bundle is written to a temporary file renamed over bundle_file once it is complete, so
+   a reader sees either the previous bundle or the new one.
+
+   Return:
+   The function returns 0 on success and -1 on failure.
+
+   See also:
+    <fann_create_from_bundle>, <fann_save_binary>
+ */
+FANN_EXTERNAL int FANN_API fann_save_bundle(const char *bundle_file, struct fann **anns,
+											unsigned int num_anns, const char *metadata,
+											enum fann_precision_enum precision);
+
+/* Function: fann_create_from_bundle
+
+   Constructs the networks of a file saved by <fann_save_bundle> into anns, which has room for
+   max_anns of them. The weights of every network are mapped like <fann_create_from_binary>
+   does. When metadata is not NULL, it receives the metadata as an allocated string ending
+   with a zero, to be freed by the caller.
+
+   Either every network is loaded or none is.
+
+   Return:
+   The number of networks, or 0 on failure.
+
+   See also:
+    <fann_save_bundle>, <fann_create_from_binary>
+ */
+FANN_EXTERNAL unsigned int FANN_API fann_create_from_bundle(const char *bundle_file, struct fann **anns,
+															unsigned int max_anns, char **metadata);
+
+/* Function: fann_save_checkpoint
+
+   Saves the network like <fann_save>, followed by everything else the training needs to go on
+   exactly where it stopped:
+   - the slopes, steps and deltas kept by the training algorithms,
+   - the SARPROP epoch and the Adam timestep,
+   - the parameters <fann_save> leaves out or rounds, like <fann_set_batch_size>, the Adam and
+     SARPROP parameters, <fann_set_activation_approximation> and the learning rate,
+   - the mask of the connections pruned by <fann_prune_connections>,
+   - the precision and the int8 calibration.
+
+   The checkpoint is written to *configuration_file* with ".tmp" appended and then renamed to
+   *configuration_file*, so a process killed while saving leaves the previous checkpoint intact.
+
+   Return:
+   The function returns 0 on success and -1 on failure.
+
+   See also:
+    <fann_create_from_checkpoint>, <fann_save_checkpoint_to_fd>
+ */
+FANN_EXTERNAL int FANN_API fann_save_checkpoint(struct fann *ann, const char *configuration_file);
+
+/* Function: fann_save_checkpoint_to_fd
+
+   Writes the checkpoint of <fann_save_checkpoint> to a file opened for writing, after whatever
+   the caller already wrote to it, so the state of the caller's own training loop can be kept in
+   the same file.
+
+   Return:
+   The function returns 0 on success and -1 on failure.
+
+   See also:
+    <fann_create_from_checkpoint_fd>
+ */
+FANN_EXTERNAL int FANN_API fann_save_checkpoint_to_fd(struct fann *ann, FILE *file);
+
+/* Function: fann_create_from_checkpoint
+
+   Constructs a network from a checkpoint saved by <fann_save_checkpoint>, ready to go on
+   training. Training it gives the same weights as if the saved network had gone on training.
+
+   See also:
+    <fann_save_checkpoint>, <fann_create_from_checkpoint_fd>
+ */
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_checkpoint(const char *configuration_file);
+
+/* Function: fann_create_from_checkpoint_fd
+
+   Reads a checkpoint written by <fann_save_checkpoint_to_fd> from the current position of a
+   file opened for reading, and leaves the file right after it.
+
+   See also:
+    <fann_save_checkpoint_to_fd>
+ */
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_checkpoint_fd(FILE *file);
+
+#endif
+
+#endif
+
+
+/* Function: fann_create_standard
+
+	Creates a standard fully connected backpropagation neural network.
+
+	There will be a bias neuron in each layer (except the output layer),
+	and this bias neuron will be connected to all neurons in the next layer.
+	When running the network, the bias nodes always emits 1.
+
+	To destroy a <struct fann> use the <fann_destroy> function.
+
+	Parameters:
+		num_layers - The total number of layers including the input and the output layer.
+		... - Integer values determining the number of neurons in each layer starting with the
+			input layer and ending with the output layer.
+
+	Returns:
+		A pointer to the newly created <struct fann>.
+
+	Example:
+		> // Creating an ANN with 2 input neurons, 1 output neuron,
+		> // and two hidden layers with 8 and 9 neurons
+		> struct fann *ann = fann_create_standard(4, 2, 8, 9, 1);
+
+	See also:
+		<fann_create_standard_array>, <fann_create_sparse>, <fann_create_shortcut>
+
+	This function appears in FANN >= 2.0.0.
+*/
+FANN_EXTERNAL struct fann *FANN_API fann_create_standard(unsigned int num_layers, ...);
+
+/* Function: fann_create_standard_array
+   Just like <fann_create_standard>, but with an array of layer sizes
+   instead of individual parameters.
 
 	Example:
 		> // Creating an ANN with 2 input neurons, 1 output neuron,
@@ -3612,6 +4495,49 @@ FANN_EXTERNAL struct fann * FANN_API fann_copy(struct fann *ann);
 */
 FANN_EXTERNAL fann_type * FANN_API fann_run(struct fann *ann, fann_type * input);
 
+/* Function: fann_set_precision
+	Sets the precision used by <fann_run> for this network, see <fann_precision_enum>.
+
+	The weights are converted when this function is called and again, lazily, after they are
+	changed by the training functions or by <fann_set_weights>, so it can be called right after
+	creating or loading a network. Weights written directly to the weight array are only picked
+	up by calling this function again.
+
+	Returns 0 on success and -1 if the converted weights could not be allocated, or the network
+	can not use the precision, in which case the network keeps running with <FANN_PRECISION_DEFAULT>.
+
+	<FANN_PRECISION_INT8> can only be set after <fann_calibrate_int8>.
+
+	See also:
+		<fann_get_precision>, <fann_precision_enum>
+*/
+FANN_EXTERNAL int FANN_API fann_set_precision(struct fann *ann, enum fann_precision_enum precision);
+
+/* Function: fann_calibrate_int8
+	Runs the data through the network with <FANN_PRECISION_DEFAULT> and stores, for each layer,
+	the scale that maps the largest absolute neuron value seen to 127. These scales are used by
+	<FANN_PRECISION_INT8>, so the data should look like the data the network will be run on,
+	but should not be the data used to measure its accuracy.
+
+	The weights are quantized by <fann_set_precision>, so calibrating only needs to be done again
+	when the range of the neuron values changes, not after every change to the weights.
+
+	Returns 0 on success and -1 if the network is not a fully connected <FANN_NETTYPE_LAYER>
+	network or the data does not match it.
+
+	See also:
+		<fann_set_precision>, <fann_precision_enum>
+*/
+FANN_EXTERNAL int FANN_API fann_calibrate_int8(struct fann *ann, struct fann_train_data *data);
+
+/* Function: fann_get_precision
+	Returns the precision used by <fann_run> for this network, see <fann_precision_enum>.
+
+	See also:
+		<fann_set_precision>
+*/
+FANN_EXTERNAL enum fann_precision_enum FANN_API fann_get_precision(struct fann *ann);
+
 /* Function: fann_randomize_weights
 	Give each connection a random weight between *min_weight* and *max_weight*
 
@@ -3882,6 +4808,147 @@ FANN_EXTERNAL void FANN_API fann_get_weights(struct fann *ann, fann_type *weight
 */
 FANN_EXTERNAL void FANN_API fann_set_weights(struct fann *ann, fann_type *weights);
 
+/* Function: fann_rewind_weights
+	Sets the weights of the kept connections back to *weights*, as <fann_set_weights> does, and
+	clears what the training algorithms learned about the old ones: the slopes, the steps, the
+	momentum and the Adam moments. Pruned connections stay pruned at 0, so pruning a trained
+	network and rewinding it to the weights it started from retrains the same sparse network
+	from its original initialisation, as in lottery ticket pruning.
+
+	*weights* holds <fann_get_total_connections> weights, as filled by <fann_get_weights>.
+
+	See also:
+		<fann_get_weights>, <struct fann_pruning_schedule>
+*/
+FANN_EXTERNAL void FANN_API fann_rewind_weights(struct fann *ann, const fann_type *weights);
+
+/* Function: fann_prune_connections
+	Prunes every connection whose weight is smaller than *threshold* in absolute value: its
+	weight is set to 0 and stays 0 through training, <fann_randomize_weights>, <fann_init_weights>
+	and <fann_set_weights>. Connections pruned by earlier calls stay pruned.
+
+	When at most one connection in five is kept, <fann_run> and the training algorithms only
+	go through the kept connections of fully connected networks, so pruned connections cost
+	nothing. Above that the pruned weights are multiplied as zeros, which is faster than going
+	through the kept connections one by one.
+
+	The mask of pruned connections is not saved by <fann_save>, only by <fann_save_binary> and
+	<fann_save_checkpoint>, and is removed by cascade training.
+
+	Returns the number of connections that are kept.
+
+	See also:
+		<fann_set_connection_mask>, <fann_get_total_active_connections>
+*/
+FANN_EXTERNAL unsigned int FANN_API fann_prune_connections(struct fann *ann, fann_type threshold);
+
+/* Function: fann_prune_smallest_connections
+	Prunes the connections with the smallest weights in absolute value until exactly *sparsity*
+	of all the connections are pruned, as <fann_prune_connections> would with the threshold
+	that reaches that sparsity. Connections pruned by earlier calls stay pruned and count
+	towards the sparsity, so nothing changes when they are already as many. Among weights equal
+	to the threshold, the ones with the lowest index are pruned first.
+
+	The weights are not sorted: one pass counts them in a histogram of the leading bits of their
+	absolute values, a second one gathers the few in the bin that holds the threshold, and the
+	threshold is selected among those. With OpenMP the histogram of a large network is split
+	across <fann_get_num_threads> threads.
+
+	Returns the number of connections that are kept.
+
+	See also:
+		<fann_prune_connections>, <fann_get_total_active_connections>
+*/
+FANN_EXTERNAL unsigned int FANN_API fann_prune_smallest_connections(struct fann *ann, float sparsity);
+
+/* Function: fann_prune_smallest_layer_connections
+	Like <fann_prune_smallest_connections>, but only among the connections into *layer*, where
+	layer 1 is the first hidden layer and the last layer is the output layer, as in
+	<fann_get_layer_array>. When *keep_bias* is not 0, the connections from bias neurons are
+	never pruned and *sparsity* is the share of the other connections of the layer.
+
+	Returns the number of connections of the network that are kept.
+
+	See also:
+		<fann_prune_smallest_connections>, <struct fann_pruning_schedule>
+*/
+FANN_EXTERNAL unsigned int FANN_API fann_prune_smallest_layer_connections(struct fann *ann,
+																		  unsigned int layer,
+																		  float sparsity,
+																		  int keep_bias);
+
+/* Function: fann_init_pruning_schedule
+	Sets up *schedule* to grow the sparsity from 0 at *first_step* to *final_sparsity* at
+	*last_step* as described by *type*, pruning at every step and without a callback. The
+	other fields of <struct fann_pruning_schedule> can be changed afterwards.
+
+	See also:
+		<fann_prune_on_schedule>, <fann_get_scheduled_sparsity>
+*/
+FANN_EXTERNAL void FANN_API fann_init_pruning_schedule(struct fann_pruning_schedule *schedule,
+													   enum fann_pruning_schedule_enum type,
+													   float final_sparsity, unsigned int first_step,
+													   unsigned int last_step);
+
+/* Function: fann_get_scheduled_sparsity
+	Returns the sparsity *schedule* asks for at *step*: initial_sparsity before first_step,
+	final_sparsity from last_step on, and the curve of <fann_pruning_schedule_enum> in between.
+
+	See also:
+		<fann_prune_on_schedule>
+*/
+FANN_EXTERNAL float FANN_API fann_get_scheduled_sparsity(const struct fann_pruning_schedule *schedule,
+														 unsigned int step);
+
+/* Function: fann_prune_on_schedule
+	Called once per step of a training loop: on the steps *schedule* prunes at, prunes the
+	network with <fann_prune_smallest_connections> to the sparsity of <fann_get_scheduled_sparsity>
+	and calls the callback of the schedule. With layer_sparsity or keep_bias, each layer is
+	pruned on its own with <fann_prune_smallest_layer_connections>, to the sparsity the curve
+	gives for its own final sparsity. With rewind_weights, the kept connections are then rewound
+	with <fann_rewind_weights> whenever new connections were pruned.
+
+	Returns the fraction of the connections of the network that are pruned, whether it pruned
+	at this step or not.
+
+	See also:
+		<fann_init_pruning_schedule>, <fann_prune_smallest_connections>
+*/
+FANN_EXTERNAL float FANN_API fann_prune_on_schedule(struct fann *ann,
+													const struct fann_pruning_schedule *schedule,
+													unsigned int step);
+
+/* Function: fann_set_connection_mask
+	Sets which connections are kept, from an array of <fann_get_total_connections> values indexed
+	like the weights: 0 prunes the connection and anything else keeps it. Unlike
+	<fann_prune_connections> this can also keep connections that were pruned before, with a weight
+	of 0. A NULL mask keeps every connection.
+
+	Returns 0 on success and -1 if the mask could not be allocated.
+
+	See also:
+		<fann_get_connection_mask>, <fann_prune_connections>
+*/
+FANN_EXTERNAL int FANN_API fann_set_connection_mask(struct fann *ann, const unsigned char *mask);
+
+/* Function: fann_get_connection_mask
+	Writes 1 for each kept connection and 0 for each pruned one to *mask*, which must have room
+	for <fann_get_total_connections> values.
+
+	See also:
+		<fann_set_connection_mask>, <fann_prune_connections>
+*/
+FANN_EXTERNAL void FANN_API fann_get_connection_mask(struct fann *ann, unsigned char *mask);
+
+/* Function: fann_get_total_active_connections
+	Returns the number of connections that are not pruned, which is <fann_get_total_connections>
+	when no connection was pruned.
+
+	See also:
+		<fann_prune_connections>
+*/
+FANN_EXTERNAL unsigned int FANN_API fann_get_total_active_connections(struct fann *ann);
+
 
 /* Function: fann_set_user_data
 
@@ -3999,6 +5066,15 @@ FANN_EXTERNAL unsigned int FANN_API fann_get_multiplier(struct fann *ann);
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <stdint.h>
+
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(__AVX2__) || defined(__SSSE3__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 /* #define FANN_NO_SEED */
 
@@ -4531,29 +5607,27 @@ FANN_EXTERNAL struct fann *FANN_API fann_create_shortcut_array(unsigned int num_
 
 FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 {
-	struct fann_neuron *neuron_it, *last_neuron, *neurons, **neuron_pointers;
-	unsigned int i, num_connections, num_input, num_output;
-	fann_type neuron_sum, *output;
-	fann_type *weights;
-	struct fann_layer *layer_it, *last_layer;
-	unsigned int activation_function;
-	fann_type steepness;
-
-	/* store some variabels local for fast access */
-	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int i, num_input;
+	fann_type *values = ann->values;
 
 #ifdef FIXEDFANN
 	int multiplier = ann->multiplier;
-	unsigned int decimal_point = ann->decimal_point;
-
-	/* values used for the stepwise linear sigmoid function */
-	fann_type r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0, r6 = 0;
-	fann_type v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
-
-	fann_type last_steepness = 0;
-	unsigned int last_activation_function = 0;
 #else
-	fann_type max_sum = 0;
+	/* on failure the conversion falls back to FANN_PRECISION_DEFAULT */
+	if(ann->precision != FANN_PRECISION_DEFAULT && ann->precision_stale)
+		fann_convert_precision_weights(ann);
+
+	switch (ann->precision)
+	{
+		case FANN_PRECISION_FLOAT:
+		case FANN_PRECISION_HALF:
+		case FANN_PRECISION_BFLOAT16:
+			return fann_run_float(ann, input);
+		case FANN_PRECISION_INT8:
+			return fann_run_int8(ann, input);
+		case FANN_PRECISION_DEFAULT:
+			break;
+	}
 #endif
 
 	/* first set the input */
@@ -4568,17 +5642,56 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 				 i, multiplier, multiplier, input[i]);
 		}
 #endif
-		first_neuron[i].value = input[i];
+		values[i] = input[i];
 	}
 	/* Set the bias neuron in the input layer */
 #ifdef FIXEDFANN
-	(ann->first_layer->last_neuron - 1)->value = multiplier;
+	values[num_input] = multiplier;
+#else
+	values[num_input] = 1;
+#endif
+
+	fann_run_layers(ann, ann->first_layer + 1);
+	return ann->output;
+}
+
+/* INTERNAL FUNCTION
+   Runs the layers from first_layer to the output layer, as fann_run does with
+   FANN_PRECISION_DEFAULT, from the values already set in the layers before first_layer,
+   and copies the output. fann_run runs every layer but the input one with it.
+ */
+void fann_run_layers(struct fann *ann, struct fann_layer *first_layer)
+{
+	struct fann_neuron *neuron_it, *last_neuron, **neuron_pointers;
+	unsigned int i, num_connections, num_output;
+	fann_type neuron_sum, *output;
+	fann_type *weights, *prev_values;
+	struct fann_layer *layer_it, *last_layer;
+	unsigned int activation_function;
+	fann_type steepness;
+
+	/* store some variabels local for fast access */
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	fann_type *values = ann->values;
+	fann_type *sums = ann->sums;
+
+#ifdef FIXEDFANN
+	int multiplier = ann->multiplier;
+	unsigned int decimal_point = ann->decimal_point;
+
+	/* values used for the stepwise linear sigmoid function */
+	fann_type r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0, r6 = 0;
+	fann_type v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
+
+	fann_type last_steepness = 0;
+	unsigned int last_activation_function = 0;
 #else
-	(ann->first_layer->last_neuron - 1)->value = 1;
+	fann_type max_sum = 0;
+	const unsigned int *active;
 #endif
 
 	last_layer = ann->last_layer;
-	for(layer_it = ann->first_layer + 1; layer_it != last_layer; layer_it++)
+	for(layer_it = first_layer; layer_it != last_layer; layer_it++)
 	{
 		last_neuron = layer_it->last_neuron;
 		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
@@ -4587,9 +5700,9 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 			{
 				/* bias neurons */
 #ifdef FIXEDFANN
-				neuron_it->value = multiplier;
+				values[neuron_it - first_neuron] = multiplier;
 #else
-				neuron_it->value = 1;
+				values[neuron_it - first_neuron] = 1;
 #endif
 				continue;
 			}
@@ -4605,24 +5718,35 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 			{
 				if(ann->network_type == FANN_NETTYPE_SHORTCUT)
 				{
-					neurons = ann->first_layer->first_neuron;
+					prev_values = values;
 				}
 				else
 				{
-					neurons = (layer_it - 1)->first_neuron;
+					prev_values = values + ((layer_it - 1)->first_neuron - first_neuron);
 				}
 
-
+#ifndef FIXEDFANN
+				if(ann->active_offsets != NULL)
+				{
+					active = ann->active_first + (neuron_it - first_neuron);
+					neuron_sum = fann_sparse_dot(weights, prev_values, ann->active_offsets + active[0],
+												 active[1] - active[0]);
+				}
+				else
+				{
+					neuron_sum = fann_dot(weights, prev_values, num_connections);
+				}
+#else
 				/* unrolled loop start */
 				i = num_connections & 3;	/* same as modulo 4 */
 				switch (i)
 				{
 					case 3:
-						neuron_sum += fann_mult(weights[2], neurons[2].value);
+						neuron_sum += fann_mult(weights[2], prev_values[2]);
 					case 2:
-						neuron_sum += fann_mult(weights[1], neurons[1].value);
+						neuron_sum += fann_mult(weights[1], prev_values[1]);
 					case 1:
-						neuron_sum += fann_mult(weights[0], neurons[0].value);
+						neuron_sum += fann_mult(weights[0], prev_values[0]);
 					case 0:
 						break;
 				}
@@ -4630,17 +5754,18 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 				for(; i != num_connections; i += 4)
 				{
 					neuron_sum +=
-						fann_mult(weights[i], neurons[i].value) +
-						fann_mult(weights[i + 1], neurons[i + 1].value) +
-						fann_mult(weights[i + 2], neurons[i + 2].value) +
-						fann_mult(weights[i + 3], neurons[i + 3].value);
+						fann_mult(weights[i], prev_values[i]) +
+						fann_mult(weights[i + 1], prev_values[i + 1]) +
+						fann_mult(weights[i + 2], prev_values[i + 2]) +
+						fann_mult(weights[i + 3], prev_values[i + 3]);
 				}
 				/* unrolled loop end */
+#endif
 
 				/*
 				 * for(i = 0;i != num_connections; i++){
-				 * printf("%f += %f*%f, ", neuron_sum, weights[i], neurons[i].value);
-				 * neuron_sum += fann_mult(weights[i], neurons[i].value);
+				 * printf("%f += %f*%f, ", neuron_sum, weights[i], prev_values[i]);
+				 * neuron_sum += fann_mult(weights[i], prev_values[i]);
 				 * }
 				 */
 			}
@@ -4652,11 +5777,11 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 				switch (i)
 				{
 					case 3:
-						neuron_sum += fann_mult(weights[2], neuron_pointers[2]->value);
+						neuron_sum += fann_mult(weights[2], values[neuron_pointers[2] - first_neuron]);
 					case 2:
-						neuron_sum += fann_mult(weights[1], neuron_pointers[1]->value);
+						neuron_sum += fann_mult(weights[1], values[neuron_pointers[1] - first_neuron]);
 					case 1:
-						neuron_sum += fann_mult(weights[0], neuron_pointers[0]->value);
+						neuron_sum += fann_mult(weights[0], values[neuron_pointers[0] - first_neuron]);
 					case 0:
 						break;
 				}
@@ -4664,15 +5789,15 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 				for(; i != num_connections; i += 4)
 				{
 					neuron_sum +=
-						fann_mult(weights[i], neuron_pointers[i]->value) +
-						fann_mult(weights[i + 1], neuron_pointers[i + 1]->value) +
-						fann_mult(weights[i + 2], neuron_pointers[i + 2]->value) +
-						fann_mult(weights[i + 3], neuron_pointers[i + 3]->value);
+						fann_mult(weights[i], values[neuron_pointers[i] - first_neuron]) +
+						fann_mult(weights[i + 1], values[neuron_pointers[i + 1] - first_neuron]) +
+						fann_mult(weights[i + 2], values[neuron_pointers[i + 2] - first_neuron]) +
+						fann_mult(weights[i + 3], values[neuron_pointers[i + 3] - first_neuron]);
 				}
 			}
 
 #ifdef FIXEDFANN
-			neuron_it->sum = fann_mult(steepness, neuron_sum);
+			sums[neuron_it - first_neuron] = fann_mult(steepness, neuron_sum);
 
 			if(activation_function != last_activation_function || steepness != last_steepness)
 			{
@@ -4717,36 +5842,36 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 			{
 				case FANN_SIGMOID:
 				case FANN_SIGMOID_STEPWISE:
-					neuron_it->value =
+					values[neuron_it - first_neuron] =
 						(fann_type) fann_stepwise(v1, v2, v3, v4, v5, v6, r1, r2, r3, r4, r5, r6, 0,
 												  multiplier, neuron_sum);
 					break;
 				case FANN_SIGMOID_SYMMETRIC:
 				case FANN_SIGMOID_SYMMETRIC_STEPWISE:
-					neuron_it->value =
+					values[neuron_it - first_neuron] =
 						(fann_type) fann_stepwise(v1, v2, v3, v4, v5, v6, r1, r2, r3, r4, r5, r6,
 												  -multiplier, multiplier, neuron_sum);
 					break;
 				case FANN_THRESHOLD:
-					neuron_it->value = (fann_type) ((neuron_sum < 0) ? 0 : multiplier);
+					values[neuron_it - first_neuron] = (fann_type) ((neuron_sum < 0) ? 0 : multiplier);
 					break;
 				case FANN_THRESHOLD_SYMMETRIC:
-					neuron_it->value = (fann_type) ((neuron_sum < 0) ? -multiplier : multiplier);
+					values[neuron_it - first_neuron] = (fann_type) ((neuron_sum < 0) ? -multiplier : multiplier);
 					break;
 				case FANN_LINEAR:
-					neuron_it->value = neuron_sum;
+					values[neuron_it - first_neuron] = neuron_sum;
 					break;
 				case FANN_LINEAR_PIECE:
-					neuron_it->value = (fann_type)((neuron_sum < 0) ? 0 : (neuron_sum > multiplier) ? multiplier : neuron_sum);
+					values[neuron_it - first_neuron] = (fann_type)((neuron_sum < 0) ? 0 : (neuron_sum > multiplier) ? multiplier : neuron_sum);
 					break;
 				case FANN_LINEAR_PIECE_SYMMETRIC:
-					neuron_it->value = (fann_type)((neuron_sum < -multiplier) ? -multiplier : (neuron_sum > multiplier) ? multiplier : neuron_sum);
+					values[neuron_it - first_neuron] = (fann_type)((neuron_sum < -multiplier) ? -multiplier : (neuron_sum > multiplier) ? multiplier : neuron_sum);
 					break;
 				case FANN_RELU:
-					neuron_it->value = (fann_type)(neuron_sum > 0 ? neuron_sum : 0);
+					values[neuron_it - first_neuron] = (fann_type)(neuron_sum > 0 ? neuron_sum : 0);
 					break;
 				case FANN_LEAKY_RELU:
-					neuron_it->value = (fann_type)(neuron_sum > 0 ? neuron_sum : neuron_sum / 100);
+					values[neuron_it - first_neuron] = (fann_type)(neuron_sum > 0 ? neuron_sum : neuron_sum / 100);
 					break;
 				case FANN_ELLIOT:
 				case FANN_ELLIOT_SYMMETRIC:
@@ -4769,1119 +5894,3958 @@ FANN_EXTERNAL fann_type *FANN_API fann_run(struct fann * ann, fann_type * input)
 			else if(neuron_sum < -max_sum)
 				neuron_sum = -max_sum;
 
-			neuron_it->sum = neuron_sum;
+			sums[neuron_it - first_neuron] = neuron_sum;
 
-			fann_activation_switch(activation_function, neuron_sum, neuron_it->value);
+			if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+				fann_activation_switch(activation_function, neuron_sum, values[neuron_it - first_neuron]);
 #endif
 		}
+#ifndef FIXEDFANN
+		if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+			fann_activate_layer(ann, layer_it->first_neuron, last_neuron);
+#endif
 	}
 
 	/* set the output */
 	output = ann->output;
 	num_output = ann->num_output;
-	neurons = (ann->last_layer - 1)->first_neuron;
+	prev_values = values + ((ann->last_layer - 1)->first_neuron - first_neuron);
 	for(i = 0; i != num_output; i++)
 	{
-		output[i] = neurons[i].value;
+		output[i] = prev_values[i];
 	}
-	return ann->output;
 }
 
-FANN_EXTERNAL void FANN_API fann_destroy(struct fann *ann)
-{
-	if(ann == NULL)
-		return;
-	fann_safe_free(ann->weights);
-	fann_safe_free(ann->connections);
-	fann_safe_free(ann->first_layer->first_neuron);
-	fann_safe_free(ann->first_layer);
-	fann_safe_free(ann->output);
-	fann_safe_free(ann->train_errors);
-	fann_safe_free(ann->train_slopes);
-	fann_safe_free(ann->prev_train_slopes);
-	fann_safe_free(ann->prev_steps);
-	fann_safe_free(ann->prev_weights_deltas);
-	fann_safe_free(ann->errstr);
-	fann_safe_free(ann->cascade_activation_functions);
-	fann_safe_free(ann->cascade_activation_steepnesses);
-	fann_safe_free(ann->cascade_candidate_scores);
-
 #ifndef FIXEDFANN
-	fann_safe_free( ann->scale_mean_in );
-	fann_safe_free( ann->scale_deviation_in );
-	fann_safe_free( ann->scale_new_min_in );
-	fann_safe_free( ann->scale_factor_in );
 
-	fann_safe_free( ann->scale_mean_out );
-	fann_safe_free( ann->scale_deviation_out );
-	fann_safe_free( ann->scale_new_min_out );
-	fann_safe_free( ann->scale_factor_out );
-#endif
+/* INTERNAL FUNCTION
+   Dot product of two fann_type arrays, the neuron values of a layer being contiguous.
+   Uses the same eight partial sums as fann_dot_float, which add the products in another
+   order than one running sum, so the result is only equal to it within rounding.
+ */
+fann_type fann_dot(const fann_type *a, const fann_type *b, unsigned int n)
+{
+	fann_type lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	const fann_type *lanes_end = a + (n & ~7u);
+	const fann_type *a_end = a + n;
+	unsigned int j;
+	fann_type sum;
 
-	fann_safe_free(ann);
-}
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] += a[j] * b[j];
+		}
+	}
 
-FANN_EXTERNAL void FANN_API fann_randomize_weights(struct fann *ann, fann_type min_weight,
-												   fann_type max_weight)
+	sum = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+	for(; a != a_end; a++, b++)
+	{
+		sum += *a * *b;
+	}
+	return sum;
+}
+
+/* INTERNAL FUNCTION
+   y += alpha * x, used to propagate the error of a neuron back through its weights and to
+   add its slopes. Each step loads eight elements of x and y before storing any of them,
+   so the compiler can use vector registers without checking whether x and y overlap.
+ */
+void fann_axpy(fann_type *y, fann_type alpha, const fann_type *x, unsigned int n)
 {
-	fann_type *last_weight;
-	fann_type *weights = ann->weights;
+	fann_type lanes[8];
+	const fann_type *lanes_end = x + (n & ~7u);
+	const fann_type *x_end = x + n;
+	unsigned int j;
 
-	last_weight = weights + ann->total_connections;
-	for(; weights != last_weight; weights++)
+	for(; x != lanes_end; x += 8, y += 8)
 	{
-		*weights = (fann_type) (fann_rand(min_weight, max_weight));
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] = y[j] + alpha * x[j];
+		}
+		for(j = 0; j != 8; j++)
+		{
+			y[j] = lanes[j];
+		}
 	}
 
-#ifndef FIXEDFANN
-	if(ann->prev_train_slopes != NULL)
+	for(; x != x_end; x++, y++)
 	{
-		fann_clear_train_arrays(ann);
+		*y += alpha * *x;
 	}
-#endif
 }
 
-/* deep copy of the fann structure */
-FANN_EXTERNAL struct fann* FANN_API fann_copy(struct fann* orig)
+/* INTERNAL FUNCTION
+   The weight update of incremental training for the connections of one neuron:
+   delta = alpha * x + momentum * deltas, weights += delta and deltas = delta.
+   Vectorized the same way as fann_axpy.
+ */
+void fann_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+						fann_type momentum, unsigned int n)
 {
-    struct fann* copy;
-    unsigned int num_layers = (unsigned int)(orig->last_layer - orig->first_layer);
-    struct fann_layer *orig_layer_it, *copy_layer_it;
-    unsigned int layer_size;
-    struct fann_neuron *last_neuron,*orig_neuron_it,*copy_neuron_it;
-    unsigned int i;
-    struct fann_neuron *orig_first_neuron,*copy_first_neuron;
-    unsigned int input_neuron;
+	fann_type lanes[8];
+	const fann_type *lanes_end = x + (n & ~7u);
+	const fann_type *x_end = x + n;
+	unsigned int j;
 
-    copy = fann_allocate_structure(num_layers);
-    if (copy==NULL) {
-        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
-        return NULL;
-    }
-    copy->errno_f = orig->errno_f;
-    if (orig->errstr)
-    {
-        copy->errstr = (char *) malloc(FANN_ERRSTR_MAX);
-        if (copy->errstr == NULL)
-        {
-            fann_destroy(copy);
-            return NULL;
-        }
-        strcpy(copy->errstr,orig->errstr);
-    }
-    copy->error_log = orig->error_log;
+	for(; x != lanes_end; x += 8, weights += 8, deltas += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] = alpha * x[j] + momentum * deltas[j];
+		}
+		for(j = 0; j != 8; j++)
+		{
+			weights[j] += lanes[j];
+			deltas[j] = lanes[j];
+		}
+	}
 
-    copy->learning_rate = orig->learning_rate;
-    copy->learning_momentum = orig->learning_momentum;
-    copy->connection_rate = orig->connection_rate;
-    copy->network_type = orig->network_type;
-    copy->num_MSE = orig->num_MSE;
-    copy->MSE_value = orig->MSE_value;
-    copy->num_bit_fail = orig->num_bit_fail;
-    copy->bit_fail_limit = orig->bit_fail_limit;
-    copy->train_error_function = orig->train_error_function;
-    copy->train_stop_function = orig->train_stop_function;
-	copy->training_algorithm = orig->training_algorithm;
-    copy->callback = orig->callback;
-	copy->user_data = orig->user_data;
-#ifndef FIXEDFANN
-    copy->cascade_output_change_fraction = orig->cascade_output_change_fraction;
-    copy->cascade_output_stagnation_epochs = orig->cascade_output_stagnation_epochs;
-    copy->cascade_candidate_change_fraction = orig->cascade_candidate_change_fraction;
-    copy->cascade_candidate_stagnation_epochs = orig->cascade_candidate_stagnation_epochs;
-    copy->cascade_best_candidate = orig->cascade_best_candidate;
-    copy->cascade_candidate_limit = orig->cascade_candidate_limit;
-    copy->cascade_weight_multiplier = orig->cascade_weight_multiplier;
-    copy->cascade_max_out_epochs = orig->cascade_max_out_epochs;
-    copy->cascade_max_cand_epochs = orig->cascade_max_cand_epochs;
+	for(; x != x_end; x++, weights++, deltas++)
+	{
+		*deltas = alpha * *x + momentum * *deltas;
+		*weights += *deltas;
+	}
+}
 
-   /* copy cascade activation functions */
-    copy->cascade_activation_functions_count = orig->cascade_activation_functions_count;
-    copy->cascade_activation_functions = (enum fann_activationfunc_enum *)realloc(copy->cascade_activation_functions,
-        copy->cascade_activation_functions_count * sizeof(enum fann_activationfunc_enum));
-    if(copy->cascade_activation_functions == NULL)
-    {
-        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
-        fann_destroy(copy);
-        return NULL;
-    }
-    memcpy(copy->cascade_activation_functions,orig->cascade_activation_functions,
-            copy->cascade_activation_functions_count * sizeof(enum fann_activationfunc_enum));
+/* INTERNAL FUNCTION
+   Square roots of eight non-negative values, in place. gcc only vectorizes sqrt with
+   -fno-math-errno, so the SSE2 or AVX instructions are used directly when available.
+ */
+void fann_sqrt8(fann_type *lanes)
+{
+#if defined(FLOATFANN) && defined(__AVX__)
+	_mm256_storeu_ps(lanes, _mm256_sqrt_ps(_mm256_loadu_ps(lanes)));
+#elif defined(FLOATFANN) && defined(__SSE2__)
+	_mm_storeu_ps(lanes, _mm_sqrt_ps(_mm_loadu_ps(lanes)));
+	_mm_storeu_ps(lanes + 4, _mm_sqrt_ps(_mm_loadu_ps(lanes + 4)));
+#elif defined(DOUBLEFANN) && defined(__AVX__)
+	_mm256_storeu_pd(lanes, _mm256_sqrt_pd(_mm256_loadu_pd(lanes)));
+	_mm256_storeu_pd(lanes + 4, _mm256_sqrt_pd(_mm256_loadu_pd(lanes + 4)));
+#elif defined(DOUBLEFANN) && defined(__SSE2__)
+	unsigned int j;
 
-    /* copy cascade activation steepnesses */
-    copy->cascade_activation_steepnesses_count = orig->cascade_activation_steepnesses_count;
-    copy->cascade_activation_steepnesses = (fann_type *)realloc(copy->cascade_activation_steepnesses, copy->cascade_activation_steepnesses_count * sizeof(fann_type));
-    if(copy->cascade_activation_steepnesses == NULL)
-    {
-        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
-        fann_destroy(copy);
-        return NULL;
-    }
-    memcpy(copy->cascade_activation_steepnesses,orig->cascade_activation_steepnesses,copy->cascade_activation_steepnesses_count * sizeof(fann_type));
+	for(j = 0; j != 8; j += 2)
+	{
+		_mm_storeu_pd(lanes + j, _mm_sqrt_pd(_mm_loadu_pd(lanes + j)));
+	}
+#else
+	unsigned int j;
 
-    copy->cascade_num_candidate_groups = orig->cascade_num_candidate_groups;
+	for(j = 0; j != 8; j++)
+	{
+		lanes[j] = (fann_type) sqrt(lanes[j]);
+	}
+#endif
+}
 
-    /* copy candidate scores, if used */
-    if (orig->cascade_candidate_scores == NULL)
-    {
-        copy->cascade_candidate_scores = NULL;
-    }
-    else
-    {
-        copy->cascade_candidate_scores =
-            (fann_type *) malloc(fann_get_cascade_num_candidates(copy) * sizeof(fann_type));
-        if(copy->cascade_candidate_scores == NULL)
-        {
-            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
-            fann_destroy(copy);
-            return NULL;
-        }
-        memcpy(copy->cascade_candidate_scores,orig->cascade_candidate_scores,fann_get_cascade_num_candidates(copy) * sizeof(fann_type));
-    }
-#endif /* FIXEDFANN */
+/* INTERNAL FUNCTION
+   fann_momentum_step for a neuron with pruned connections: the delta of each connection is
+   multiplied by its mask, so the pruned weights and their deltas stay 0.
+ */
+void fann_masked_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+							   fann_type momentum, const fann_type *mask, unsigned int n)
+{
+	fann_type lanes[8];
+	const fann_type *lanes_end = x + (n & ~7u);
+	const fann_type *x_end = x + n;
+	unsigned int j;
 
-    copy->quickprop_decay = orig->quickprop_decay;
-    copy->quickprop_mu = orig->quickprop_mu;
-    copy->rprop_increase_factor = orig->rprop_increase_factor;
-    copy->rprop_decrease_factor = orig->rprop_decrease_factor;
-    copy->rprop_delta_min = orig->rprop_delta_min;
-    copy->rprop_delta_max = orig->rprop_delta_max;
-    copy->rprop_delta_zero = orig->rprop_delta_zero;
+	for(; x != lanes_end; x += 8, weights += 8, deltas += 8, mask += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] = (alpha * x[j] + momentum * deltas[j]) * mask[j];
+		}
+		for(j = 0; j != 8; j++)
+		{
+			weights[j] += lanes[j];
+			deltas[j] = lanes[j];
+		}
+	}
 
-    /* user_data is not deep copied.  user should use fann_copy_with_user_data() for that */
-    copy->user_data = orig->user_data;
+	for(; x != x_end; x++, weights++, deltas++, mask++)
+	{
+		*deltas = (alpha * *x + momentum * *deltas) * *mask;
+		*weights += *deltas;
+	}
+}
 
-#ifdef FIXEDFANN
-    copy->decimal_point = orig->decimal_point;
-    copy->multiplier = orig->multiplier;
-    memcpy(copy->sigmoid_results,orig->sigmoid_results,6*sizeof(fann_type));
-    memcpy(copy->sigmoid_values,orig->sigmoid_values,6*sizeof(fann_type));
-    memcpy(copy->sigmoid_symmetric_results,orig->sigmoid_symmetric_results,6*sizeof(fann_type));
-    memcpy(copy->sigmoid_symmetric_values,orig->sigmoid_symmetric_values,6*sizeof(fann_type));
-#endif
+/* INTERNAL FUNCTION
+   fann_dot over the n elements of a and b at the given offsets, for the kept connections of
+   a neuron. The four partial sums hide the latency of the scattered loads.
+ */
+fann_type fann_sparse_dot(const fann_type *a, const fann_type *b, const unsigned int *offsets,
+						  unsigned int n)
+{
+	fann_type sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+	unsigned int i = 0;
 
+	for(; i + 4 <= n; i += 4)
+	{
+		sum0 += a[offsets[i]] * b[offsets[i]];
+		sum1 += a[offsets[i + 1]] * b[offsets[i + 1]];
+		sum2 += a[offsets[i + 2]] * b[offsets[i + 2]];
+		sum3 += a[offsets[i + 3]] * b[offsets[i + 3]];
+	}
+	for(; i != n; i++)
+	{
+		sum0 += a[offsets[i]] * b[offsets[i]];
+	}
+	return (sum0 + sum1) + (sum2 + sum3);
+}
 
-    /* copy layer sizes, prepare for fann_allocate_neurons */
-    for (orig_layer_it = orig->first_layer, copy_layer_it = copy->first_layer;
-            orig_layer_it != orig->last_layer; orig_layer_it++, copy_layer_it++)
-    {
-        layer_size = (unsigned int)(orig_layer_it->last_neuron - orig_layer_it->first_neuron);
-        copy_layer_it->first_neuron = NULL;
-        copy_layer_it->last_neuron = copy_layer_it->first_neuron + layer_size;
-        copy->total_neurons += layer_size;
-    }
-    copy->num_input = orig->num_input;
-    copy->num_output = orig->num_output;
+/* INTERNAL FUNCTION
+   fann_axpy over the n elements of x and y at the given offsets.
+ */
+void fann_sparse_axpy(fann_type *y, fann_type alpha, const fann_type *x, const unsigned int *offsets,
+					  unsigned int n)
+{
+	unsigned int i;
 
+	for(i = 0; i != n; i++)
+	{
+		y[offsets[i]] += alpha * x[offsets[i]];
+	}
+}
 
-    /* copy scale parameters, when used */
-#ifndef FIXEDFANN
-    if (orig->scale_mean_in != NULL)
-    {
-        fann_allocate_scale(copy);
-        for (i=0; i < orig->num_input ; i++) {
-            copy->scale_mean_in[i] = orig->scale_mean_in[i];
-            copy->scale_deviation_in[i] = orig->scale_deviation_in[i];
-            copy->scale_new_min_in[i] = orig->scale_new_min_in[i];
-            copy->scale_factor_in[i] = orig->scale_factor_in[i];
-        }
-        for (i=0; i < orig->num_output ; i++) {
-            copy->scale_mean_out[i] = orig->scale_mean_out[i];
-            copy->scale_deviation_out[i] = orig->scale_deviation_out[i];
-            copy->scale_new_min_out[i] = orig->scale_new_min_out[i];
-            copy->scale_factor_out[i] = orig->scale_factor_out[i];
-        }
-    }
-#endif
+/* INTERNAL FUNCTION
+   fann_momentum_step over the n connections at the given offsets.
+ */
+void fann_sparse_momentum_step(fann_type *weights, fann_type *deltas, fann_type alpha, const fann_type *x,
+							   fann_type momentum, const unsigned int *offsets, unsigned int n)
+{
+	unsigned int i, offset;
 
-    /* copy the neurons */
-    fann_allocate_neurons(copy);
-    if (copy->errno_f == FANN_E_CANT_ALLOCATE_MEM)
-    {
-        fann_destroy(copy);
-        return NULL;
-    }
-    layer_size = (unsigned int)((orig->last_layer-1)->last_neuron - (orig->last_layer-1)->first_neuron);
-    memcpy(copy->output,orig->output, layer_size * sizeof(fann_type));
+	for(i = 0; i != n; i++)
+	{
+		offset = offsets[i];
+		deltas[offset] = alpha * x[offset] + momentum * deltas[offset];
+		weights[offset] += deltas[offset];
+	}
+}
 
-    last_neuron = (orig->last_layer - 1)->last_neuron;
-    for (orig_neuron_it = orig->first_layer->first_neuron, copy_neuron_it = copy->first_layer->first_neuron;
-            orig_neuron_it != last_neuron; orig_neuron_it++, copy_neuron_it++)
-    {
-        memcpy(copy_neuron_it,orig_neuron_it,sizeof(struct fann_neuron));
-    }
- /* copy the connections */
-    copy->total_connections = orig->total_connections;
-    fann_allocate_connections(copy);
-    if (copy->errno_f == FANN_E_CANT_ALLOCATE_MEM)
-    {
-        fann_destroy(copy);
-        return NULL;
-    }
+/* INTERNAL FUNCTION
+   Dot product of two float arrays. The eight independent partial sums do not change
+   the order of the additions inside each one, so the compiler can keep them in a
+   single vector register without needing -ffast-math.
+ */
+float fann_dot_float(const float *a, const float *b, unsigned int n)
+{
+	float lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	const float *lanes_end = a + (n & ~7u);
+	const float *a_end = a + n;
+	unsigned int j;
+	float sum;
 
-    orig_first_neuron = orig->first_layer->first_neuron;
-    copy_first_neuron = copy->first_layer->first_neuron;
-    for (i=0; i < orig->total_connections; i++)
-    {
-        copy->weights[i] = orig->weights[i];
-        input_neuron = (unsigned int)(orig->connections[i] - orig_first_neuron);
-        copy->connections[i] = copy_first_neuron + input_neuron;
-    }
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] += a[j] * b[j];
+		}
+	}
 
-    if (orig->train_slopes)
-    {
-        copy->train_slopes = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
-        if (copy->train_slopes == NULL)
+	sum = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+	for(; a != a_end; a++, b++)
+	{
+		sum += *a * *b;
+	}
+	return sum;
+}
+
+/* INTERNAL FUNCTION
+   Dot product of half precision weights and float values, with the eight partial sums of
+   fann_dot_float. With F16C the weights are converted eight at a time by vcvtph2ps, which
+   gives the same floats, so both versions give the same result.
+ */
+float fann_dot_half(const uint16_t *a, const float *b, unsigned int n)
+{
+	float lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	const uint16_t *lanes_end = a + (n & ~7u);
+	const uint16_t *a_end = a + n;
+	float sum;
+#if defined(__F16C__) && defined(__AVX__)
+	__m256 acc = _mm256_setzero_ps();
+
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a)),
+											   _mm256_loadu_ps(b)));
+	}
+	_mm256_storeu_ps(lanes, acc);
+#else
+	unsigned int j;
+
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] += fann_half_to_float(a[j]) * b[j];
+		}
+	}
+#endif
+
+	sum = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+	for(; a != a_end; a++, b++)
+	{
+		sum += fann_half_to_float(*a) * *b;
+	}
+	return sum;
+}
+
+/* INTERNAL FUNCTION
+   Dot product of bfloat16 weights and float values, with the eight partial sums of
+   fann_dot_float. A bfloat16 only has to be shifted into the top bits of a float, which
+   AVX2 does eight at a time.
+ */
+float fann_dot_bfloat16(const uint16_t *a, const float *b, unsigned int n)
+{
+	float lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	const uint16_t *lanes_end = a + (n & ~7u);
+	const uint16_t *a_end = a + n;
+	float sum;
+#if defined(__AVX2__)
+	__m256 acc = _mm256_setzero_ps();
+	__m256i bits;
+
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		bits = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) a)), 16);
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_castsi256_ps(bits), _mm256_loadu_ps(b)));
+	}
+	_mm256_storeu_ps(lanes, acc);
+#else
+	unsigned int j;
+
+	for(; a != lanes_end; a += 8, b += 8)
+	{
+		for(j = 0; j != 8; j++)
+		{
+			lanes[j] += fann_bfloat16_to_float(a[j]) * b[j];
+		}
+	}
+#endif
+
+	sum = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+	for(; a != a_end; a++, b++)
+	{
+		sum += fann_bfloat16_to_float(*a) * *b;
+	}
+	return sum;
+}
+
+/* INTERNAL FUNCTION
+   Rounds a float to the nearest IEEE half precision value, ties to even like the F16C
+   instructions. Values from 65520 on in absolute value become infinities.
+ */
+uint16_t fann_float_to_half(float value)
+{
+	uint32_t bits, sign, mantissa, remainder, halfway, shift;
+	uint16_t half;
+
+	memcpy(&bits, &value, sizeof(bits));
+	sign = (bits >> 16) & 0x8000;
+	bits &= 0x7FFFFFFF;
+
+	if(bits > 0x7F800000)
+		return (uint16_t) (sign | 0x7E00 | ((bits >> 13) & 0x3FF));
+	if(bits >= 0x47800000)
+		return (uint16_t) (sign | 0x7C00);
+	if(bits >= 0x38800000)
+	{
+		/* a normal half, rounding can carry into the exponent, up to the infinity */
+		bits += 0xFFF + ((bits >> 13) & 1);
+		return (uint16_t) (sign | ((bits - 0x38000000) >> 13));
+	}
+
+	/* a subnormal half, the mantissa with its implicit bit shifted to units of 2^-24 */
+	shift = 126 - (bits >> 23);
+	if(shift > 24)
+		return (uint16_t) sign;
+	mantissa = (bits & 0x7FFFFF) | 0x800000;
+	half = (uint16_t) (mantissa >> shift);
+	remainder = mantissa & ((1u << shift) - 1);
+	halfway = 1u << (shift - 1);
+	if(remainder > halfway || (remainder == halfway && (half & 1)))
+		half++;
+	return (uint16_t) (sign | half);
+}
+
+/* INTERNAL FUNCTION
+   Converts an IEEE half precision value to float, exactly. Moving the bits of a finite
+   half under a float exponent 112 lower and multiplying by 2^112 gives both the normal
+   and the subnormal values, and the sign needs no branch, which the random signs of the
+   weights would mispredict.
+ */
+float fann_half_to_float(uint16_t half)
+{
+	uint32_t bits = ((uint32_t) (half & 0x8000) << 16) | ((uint32_t) (half & 0x7FFF) << 13);
+	float value;
+
+	/* infinities and NaNs get the top exponent, which the multiplication keeps */
+	if((half & 0x7C00) == 0x7C00)
+		bits |= 0x7F800000;
+	memcpy(&value, &bits, sizeof(value));
+	return value * 5.192296858534828e+33f;
+}
+
+/* INTERNAL FUNCTION
+   Converts n half precision values to float, eight at a time with F16C.
+ */
+void fann_half_to_float_array(const uint16_t *half, float *values, unsigned int n)
+{
+	unsigned int i = 0;
+
+#if defined(__F16C__) && defined(__AVX__)
+	for(; i + 8 <= n; i += 8)
+	{
+		_mm256_storeu_ps(values + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (half + i))));
+	}
+#endif
+	for(; i != n; i++)
+	{
+		values[i] = fann_half_to_float(half[i]);
+	}
+}
+
+/* INTERNAL FUNCTION
+   Rounds a float to the nearest bfloat16, ties to even, keeping NaNs quiet.
+ */
+uint16_t fann_float_to_bfloat16(float value)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	if((bits & 0x7FFFFFFF) > 0x7F800000)
+		return (uint16_t) ((bits >> 16) | 0x40);
+	return (uint16_t) ((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+/* INTERNAL FUNCTION
+   Converts a bfloat16 to float, exactly.
+ */
+float fann_bfloat16_to_float(uint16_t bfloat16)
+{
+	uint32_t bits = (uint32_t) bfloat16 << 16;
+	float value;
+
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/* INTERNAL FUNCTION
+   Dot product of two int8 arrays accumulated in int32.
+
+   The AVX2 and SSSE3 versions use the unsigned by signed multiply (vpmaddubsw), so
+   the sign of a is moved to b first. With both sides within [-127, 127] the pairs of
+   products added by vpmaddubsw can not saturate the int16 result.
+ */
+int fann_dot_int8(const signed char *a, const signed char *b, unsigned int n)
+{
+	const signed char *a_end = a + n;
+	int sum = 0;
+#if defined(__AVX2__)
+	const signed char *vector_end = a + (n & ~31u);
+	const __m256i ones = _mm256_set1_epi16(1);
+	__m256i acc = _mm256_setzero_si256();
+	__m256i va, vb, products;
+	__m128i half;
+
+	for(; a != vector_end; a += 32, b += 32)
+	{
+		va = _mm256_loadu_si256((const __m256i *) a);
+		vb = _mm256_loadu_si256((const __m256i *) b);
+		products = _mm256_maddubs_epi16(_mm256_sign_epi8(va, va), _mm256_sign_epi8(vb, va));
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(products, ones));
+	}
+	half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	half = _mm_hadd_epi32(half, half);
+	half = _mm_hadd_epi32(half, half);
+	sum = _mm_cvtsi128_si32(half);
+#elif defined(__SSSE3__)
+	const signed char *vector_end = a + (n & ~15u);
+	const __m128i ones = _mm_set1_epi16(1);
+	__m128i acc = _mm_setzero_si128();
+	__m128i va, vb, products;
+
+	for(; a != vector_end; a += 16, b += 16)
+	{
+		va = _mm_loadu_si128((const __m128i *) a);
+		vb = _mm_loadu_si128((const __m128i *) b);
+		products = _mm_maddubs_epi16(_mm_sign_epi8(va, va), _mm_sign_epi8(vb, va));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(products, ones));
+	}
+	acc = _mm_hadd_epi32(acc, acc);
+	acc = _mm_hadd_epi32(acc, acc);
+	sum = _mm_cvtsi128_si32(acc);
+#endif
+	for(; a != a_end; a++, b++)
+	{
+		sum += (int) *a * (int) *b;
+	}
+	return sum;
+}
+
+/* INTERNAL FUNCTION
+   Rounds a value, already divided by its scale, to the nearest int8 in [-127, 127]
+ */
+signed char fann_quantize_int8(float value)
+{
+	if(value >= 127)
+		return 127;
+	if(value <= -127)
+		return -127;
+	return (signed char) (value >= 0 ? (int) (value + 0.5f) : (int) (value - 0.5f));
+}
+
+/* INTERNAL FUNCTION
+   Converts the weights to the precision of the network and (re)allocates the buffers it
+   needs. If that is not possible the network falls back to FANN_PRECISION_DEFAULT.
+ */
+int fann_convert_precision_weights(struct fann *ann)
+{
+	int status = 0;
+
+	switch (ann->precision)
+	{
+		case FANN_PRECISION_FLOAT:
+			status = fann_convert_weights_float(ann);
+			break;
+		case FANN_PRECISION_INT8:
+			status = fann_convert_weights_int8(ann);
+			break;
+		case FANN_PRECISION_HALF:
+		case FANN_PRECISION_BFLOAT16:
+			status = fann_convert_weights_half(ann);
+			break;
+		case FANN_PRECISION_DEFAULT:
+			break;
+	}
+
+	if(status == -1)
+	{
+		ann->precision = FANN_PRECISION_DEFAULT;
+		return -1;
+	}
+	ann->precision_stale = 0;
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Creates the single precision copy of the weights
+ */
+int fann_convert_weights_float(struct fann *ann)
+{
+	unsigned int i;
+	float *weights_float, *values_float;
+
+	weights_float = (float *) realloc(ann->weights_float, ann->total_connections * sizeof(float));
+	if(weights_float == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->weights_float = weights_float;
+
+	values_float = (float *) realloc(ann->values_float, ann->total_neurons * sizeof(float));
+	if(values_float == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->values_float = values_float;
+
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		weights_float[i] = (float) ann->weights[i];
+	}
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Creates the int8 copy of the weights, with the scale of each neuron chosen so that
+   its largest absolute weight (not counting the bias) becomes 127.
+ */
+int fann_convert_weights_int8(struct fann *ann)
+{
+	struct fann_layer *layer_it;
+	struct fann_neuron *neuron_it, *last_neuron;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int i, bias_con;
+	fann_type max_weight;
+	float scale;
+	signed char *weights_int8, *values_int8;
+	float *weights_int8_scale;
+
+	if(ann->values_int8_scale == NULL || ann->connection_rate < 1 || ann->network_type != FANN_NETTYPE_LAYER)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_USE_PRECISION);
+		return -1;
+	}
+
+	weights_int8 = (signed char *) realloc(ann->weights_int8, ann->total_connections * sizeof(signed char));
+	if(weights_int8 == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->weights_int8 = weights_int8;
+
+	weights_int8_scale = (float *) realloc(ann->weights_int8_scale, ann->total_neurons * sizeof(float));
+	if(weights_int8_scale == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->weights_int8_scale = weights_int8_scale;
+
+	values_int8 = (signed char *) realloc(ann->values_int8, ann->total_neurons * sizeof(signed char));
+	if(values_int8 == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->values_int8 = values_int8;
+
+	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+	{
+		last_neuron = layer_it->last_neuron;
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			if(neuron_it->first_con == neuron_it->last_con)
+				continue;
+
+			/* the last connection of each neuron is the bias */
+			bias_con = neuron_it->last_con - 1;
+			max_weight = 0;
+			for(i = neuron_it->first_con; i != bias_con; i++)
+			{
+				if(fann_abs(ann->weights[i]) > max_weight)
+					max_weight = fann_abs(ann->weights[i]);
+			}
+
+			scale = max_weight > 0 ? (float) max_weight / 127.0f : 1.0f;
+			weights_int8_scale[neuron_it - first_neuron] = scale;
+			for(i = neuron_it->first_con; i != bias_con; i++)
+			{
+				weights_int8[i] = fann_quantize_int8((float) ann->weights[i] / scale);
+			}
+			weights_int8[bias_con] = 0;
+		}
+	}
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Creates the half precision or bfloat16 copy of the weights, rounded to the nearest.
+ */
+int fann_convert_weights_half(struct fann *ann)
+{
+	unsigned int i;
+	uint16_t *weights_half;
+	float *values_float;
+
+	weights_half = (uint16_t *) realloc(ann->weights_half, ann->total_connections * sizeof(uint16_t));
+	if(weights_half == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->weights_half = weights_half;
+
+	values_float = (float *) realloc(ann->values_float, ann->total_neurons * sizeof(float));
+	if(values_float == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->values_float = values_float;
+
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		if(ann->precision == FANN_PRECISION_BFLOAT16)
+			weights_half[i] = fann_float_to_bfloat16((float) ann->weights[i]);
+		else
+			weights_half[i] = fann_float_to_half((float) ann->weights[i]);
+	}
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   The FANN_PRECISION_FLOAT version of fann_run, also used by FANN_PRECISION_HALF and
+   FANN_PRECISION_BFLOAT16, which only differ by the weights of the dot products.
+
+   The neuron values are also written to a contiguous float array, so every
+   dot product reads both the weights and the previous layer with unit stride.
+   The neurons still receive their sum and value, so the network can be trained
+   and inspected as usual after running it in float.
+ */
+fann_type *fann_run_float(struct fann *ann, fann_type * input)
+{
+	struct fann_neuron *neuron_it, *last_neuron, **neuron_pointers;
+	struct fann_layer *layer_it, *last_layer;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int i, num_connections, num_input, num_output;
+	float *values = ann->values_float;
+	float *prev_values, *weights;
+	uint16_t *weights_half;
+	float neuron_sum, max_sum, steepness, weight;
+	fann_type *neuron_values = ann->values;
+	fann_type *neuron_sums = ann->sums;
+	fann_type *output;
+
+	/* first set the input */
+	num_input = ann->num_input;
+	for(i = 0; i != num_input; i++)
+	{
+		neuron_values[i] = input[i];
+		values[i] = (float) input[i];
+	}
+	/* Set the bias neuron in the input layer */
+	neuron_values[num_input] = 1;
+	values[num_input] = 1;
+
+	last_layer = ann->last_layer;
+	for(layer_it = ann->first_layer + 1; layer_it != last_layer; layer_it++)
+	{
+		if(ann->network_type == FANN_NETTYPE_SHORTCUT)
+		{
+			prev_values = values;
+		}
+		else
+		{
+			prev_values = values + ((layer_it - 1)->first_neuron - first_neuron);
+		}
+
+		last_neuron = layer_it->last_neuron;
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			if(neuron_it->first_con == neuron_it->last_con)
+			{
+				/* bias neurons */
+				neuron_values[neuron_it - first_neuron] = 1;
+				values[neuron_it - first_neuron] = 1;
+				continue;
+			}
+
+			num_connections = neuron_it->last_con - neuron_it->first_con;
+			weights = ann->weights_float + neuron_it->first_con;
+			weights_half = ann->weights_half + neuron_it->first_con;
+
+			if(ann->connection_rate >= 1)
+			{
+				if(ann->precision == FANN_PRECISION_HALF)
+					neuron_sum = fann_dot_half(weights_half, prev_values, num_connections);
+				else if(ann->precision == FANN_PRECISION_BFLOAT16)
+					neuron_sum = fann_dot_bfloat16(weights_half, prev_values, num_connections);
+				else
+					neuron_sum = fann_dot_float(weights, prev_values, num_connections);
+			}
+			else
+			{
+				neuron_pointers = ann->connections + neuron_it->first_con;
+				neuron_sum = 0;
+				for(i = 0; i != num_connections; i++)
+				{
+					if(ann->precision == FANN_PRECISION_HALF)
+						weight = fann_half_to_float(weights_half[i]);
+					else if(ann->precision == FANN_PRECISION_BFLOAT16)
+						weight = fann_bfloat16_to_float(weights_half[i]);
+					else
+						weight = weights[i];
+					neuron_sum += weight * values[neuron_pointers[i] - first_neuron];
+				}
+			}
+
+			steepness = (float) neuron_it->activation_steepness;
+			neuron_sum = steepness * neuron_sum;
+
+			max_sum = 150 / steepness;
+			if(neuron_sum > max_sum)
+				neuron_sum = max_sum;
+			else if(neuron_sum < -max_sum)
+				neuron_sum = -max_sum;
+
+			neuron_sums[neuron_it - first_neuron] = neuron_sum;
+
+			if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+			{
+				fann_activation_switch(neuron_it->activation_function, neuron_sum, neuron_values[neuron_it - first_neuron]);
+				values[neuron_it - first_neuron] = (float) neuron_values[neuron_it - first_neuron];
+			}
+		}
+
+		if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+		{
+			fann_activate_layer(ann, layer_it->first_neuron, last_neuron);
+			for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+			{
+				values[neuron_it - first_neuron] = (float) neuron_values[neuron_it - first_neuron];
+			}
+		}
+	}
+
+	/* set the output */
+	output = ann->output;
+	num_output = ann->num_output;
+	neuron_values = ann->values + ((ann->last_layer - 1)->first_neuron - first_neuron);
+	for(i = 0; i != num_output; i++)
+	{
+		output[i] = neuron_values[i];
+	}
+	return ann->output;
+}
+
+/* INTERNAL FUNCTION
+   The FANN_PRECISION_INT8 version of fann_run.
+
+   The sum of each neuron is the int32 dot product of its int8 weights and the
+   int8 values of the previous layer, scaled back to float, plus the bias weight.
+   The activation function runs in float and its result is quantized again with
+   the scale of the layer, except in the output layer.
+ */
+fann_type *fann_run_int8(struct fann *ann, fann_type * input)
+{
+	struct fann_neuron *neuron_it, *last_neuron;
+	struct fann_layer *layer_it, *last_layer;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int i, num_input, num_output;
+	signed char *values = ann->values_int8;
+	signed char *prev_values;
+	float *layer_scales = ann->values_int8_scale;
+	float prev_scale, inverse_scale;
+	float neuron_sum, max_sum, steepness;
+	fann_type *neuron_values = ann->values;
+	fann_type *neuron_sums = ann->sums;
+	fann_type *output;
+
+	/* first set the input */
+	num_input = ann->num_input;
+	inverse_scale = 1.0f / layer_scales[0];
+	for(i = 0; i != num_input; i++)
+	{
+		neuron_values[i] = input[i];
+		values[i] = fann_quantize_int8((float) input[i] * inverse_scale);
+	}
+	/* Set the bias neuron in the input layer */
+	neuron_values[num_input] = 1;
+
+	last_layer = ann->last_layer;
+	for(layer_it = ann->first_layer + 1; layer_it != last_layer; layer_it++)
+	{
+		prev_values = values + ((layer_it - 1)->first_neuron - first_neuron);
+		prev_scale = layer_scales[layer_it - 1 - ann->first_layer];
+		inverse_scale = 1.0f / layer_scales[layer_it - ann->first_layer];
+
+		last_neuron = layer_it->last_neuron;
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			if(neuron_it->first_con == neuron_it->last_con)
+			{
+				/* bias neurons */
+				neuron_values[neuron_it - first_neuron] = 1;
+				continue;
+			}
+
+			neuron_sum = (float) fann_dot_int8(ann->weights_int8 + neuron_it->first_con, prev_values,
+				neuron_it->last_con - neuron_it->first_con - 1);
+			neuron_sum = neuron_sum * ann->weights_int8_scale[neuron_it - first_neuron] * prev_scale +
+				(float) ann->weights[neuron_it->last_con - 1];
+
+			steepness = (float) neuron_it->activation_steepness;
+			neuron_sum = steepness * neuron_sum;
+
+			max_sum = 150 / steepness;
+			if(neuron_sum > max_sum)
+				neuron_sum = max_sum;
+			else if(neuron_sum < -max_sum)
+				neuron_sum = -max_sum;
+
+			neuron_sums[neuron_it - first_neuron] = neuron_sum;
+
+			if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+			{
+				fann_activation_switch(neuron_it->activation_function, neuron_sum, neuron_values[neuron_it - first_neuron]);
+				values[neuron_it - first_neuron] = fann_quantize_int8((float) neuron_values[neuron_it - first_neuron] * inverse_scale);
+			}
+		}
+
+		if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+		{
+			fann_activate_layer(ann, layer_it->first_neuron, last_neuron);
+			for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+			{
+				values[neuron_it - first_neuron] = fann_quantize_int8((float) neuron_values[neuron_it - first_neuron] * inverse_scale);
+			}
+		}
+	}
+
+	/* set the output */
+	output = ann->output;
+	num_output = ann->num_output;
+	neuron_values = ann->values + ((ann->last_layer - 1)->first_neuron - first_neuron);
+	for(i = 0; i != num_output; i++)
+	{
+		output[i] = neuron_values[i];
+	}
+	return ann->output;
+}
+
+FANN_EXTERNAL int FANN_API fann_calibrate_int8(struct fann *ann, struct fann_train_data *data)
+{
+	struct fann_layer *layer_it;
+	fann_type *value_it, *last_value;
+	unsigned int i, num_layers = (unsigned int)(ann->last_layer - ann->first_layer);
+	enum fann_precision_enum precision = ann->precision;
+	float *layer_scales;
+	fann_type max_value;
+
+	if(ann->connection_rate < 1 || ann->network_type != FANN_NETTYPE_LAYER)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_USE_PRECISION);
+		return -1;
+	}
+	if(fann_check_input_output_sizes(ann, data) == -1)
+		return -1;
+
+	layer_scales = (float *) realloc(ann->values_int8_scale, num_layers * sizeof(float));
+	if(layer_scales == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	ann->values_int8_scale = layer_scales;
+	for(i = 0; i != num_layers; i++)
+	{
+		layer_scales[i] = 0;
+	}
+
+	/* the largest absolute value of each layer is kept in its scale until the end */
+	ann->precision = FANN_PRECISION_DEFAULT;
+	for(i = 0; i != data->num_data; i++)
+	{
+		fann_run(ann, data->input[i]);
+		for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++)
+		{
+			/* the bias neuron is always 1 and is not quantized */
+			value_it = ann->values + (layer_it->first_neuron - ann->first_layer->first_neuron);
+			last_value = ann->values + (layer_it->last_neuron - 1 - ann->first_layer->first_neuron);
+			max_value = layer_scales[layer_it - ann->first_layer];
+			for(; value_it != last_value; value_it++)
+			{
+				if(fann_abs(*value_it) > max_value)
+					max_value = fann_abs(*value_it);
+			}
+			layer_scales[layer_it - ann->first_layer] = (float) max_value;
+		}
+	}
+	ann->precision = precision;
+	ann->precision_stale = 1;
+
+	for(i = 0; i != num_layers; i++)
+	{
+		layer_scales[i] = layer_scales[i] > 0 ? layer_scales[i] / 127.0f : 1.0f;
+	}
+	return 0;
+}
+
+FANN_EXTERNAL int FANN_API fann_set_precision(struct fann *ann, enum fann_precision_enum precision)
+{
+	ann->precision = precision;
+	if(precision != FANN_PRECISION_FLOAT)
+		fann_safe_free(ann->weights_float);
+	if(precision != FANN_PRECISION_HALF && precision != FANN_PRECISION_BFLOAT16)
+		fann_safe_free(ann->weights_half);
+	if(precision != FANN_PRECISION_FLOAT && precision != FANN_PRECISION_HALF &&
+	   precision != FANN_PRECISION_BFLOAT16)
+		fann_safe_free(ann->values_float);
+	if(precision != FANN_PRECISION_INT8)
+	{
+		fann_safe_free(ann->weights_int8);
+		fann_safe_free(ann->weights_int8_scale);
+		fann_safe_free(ann->values_int8);
+	}
+	return fann_convert_precision_weights(ann);
+}
+
+#endif
+
+FANN_GET(enum fann_precision_enum, precision)
+
+FANN_EXTERNAL void FANN_API fann_destroy(struct fann *ann)
+{
+	if(ann == NULL)
+		return;
+	fann_free_weights(ann);
+	fann_safe_free(ann->connections);
+	fann_safe_free(ann->first_layer->first_neuron);
+	fann_safe_free(ann->first_layer);
+	fann_safe_free(ann->values);
+	fann_safe_free(ann->sums);
+	fann_safe_free(ann->output);
+	fann_safe_free(ann->train_errors);
+	fann_safe_free(ann->train_slopes);
+	fann_safe_free(ann->prev_train_slopes);
+	fann_safe_free(ann->prev_steps);
+	fann_safe_free(ann->prev_weights_deltas);
+	fann_safe_free(ann->weights_float);
+	fann_safe_free(ann->values_float);
+	fann_safe_free(ann->weights_half);
+	fann_safe_free(ann->weights_int8);
+	fann_safe_free(ann->weights_int8_scale);
+	fann_safe_free(ann->values_int8);
+	fann_safe_free(ann->values_int8_scale);
+	fann_destroy_parallel_workers(ann);
+	fann_safe_free(ann->batch_values);
+	fann_safe_free(ann->batch_sums);
+	fann_safe_free(ann->batch_errors);
+	fann_safe_free(ann->connection_mask);
+	fann_safe_free(ann->active_offsets);
+	fann_safe_free(ann->active_first);
+	fann_safe_free(ann->errstr);
+	fann_safe_free(ann->cascade_activation_functions);
+	fann_safe_free(ann->cascade_activation_steepnesses);
+	fann_safe_free(ann->cascade_candidate_scores);
+
+#ifndef FIXEDFANN
+	fann_safe_free( ann->scale_mean_in );
+	fann_safe_free( ann->scale_deviation_in );
+	fann_safe_free( ann->scale_new_min_in );
+	fann_safe_free( ann->scale_factor_in );
+
+	fann_safe_free( ann->scale_mean_out );
+	fann_safe_free( ann->scale_deviation_out );
+	fann_safe_free( ann->scale_new_min_out );
+	fann_safe_free( ann->scale_factor_out );
+#endif
+
+	fann_safe_free(ann);
+}
+
+FANN_EXTERNAL void FANN_API fann_randomize_weights(struct fann *ann, fann_type min_weight,
+												   fann_type max_weight)
+{
+	fann_type *last_weight;
+	fann_type *weights = ann->weights;
+
+	last_weight = weights + ann->total_connections;
+	for(; weights != last_weight; weights++)
+	{
+		*weights = (fann_type) (fann_rand(min_weight, max_weight));
+	}
+	fann_apply_connection_mask(ann, 0, ann->total_connections);
+	ann->precision_stale = 1;
+
+#ifndef FIXEDFANN
+	if(ann->prev_train_slopes != NULL)
+	{
+		fann_clear_train_arrays(ann);
+	}
+#endif
+}
+
+/* deep copy of the fann structure */
+FANN_EXTERNAL struct fann* FANN_API fann_copy(struct fann* orig)
+{
+    struct fann* copy;
+    unsigned int num_layers = (unsigned int)(orig->last_layer - orig->first_layer);
+    struct fann_layer *orig_layer_it, *copy_layer_it;
+    unsigned int layer_size;
+    struct fann_neuron *last_neuron,*orig_neuron_it,*copy_neuron_it;
+    unsigned int i;
+    struct fann_neuron *orig_first_neuron,*copy_first_neuron;
+    unsigned int input_neuron;
+
+    copy = fann_allocate_structure(num_layers);
+    if (copy==NULL) {
+        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
+        return NULL;
+    }
+    copy->errno_f = orig->errno_f;
+    if (orig->errstr)
+    {
+        copy->errstr = (char *) malloc(FANN_ERRSTR_MAX);
+        if (copy->errstr == NULL)
+        {
+            fann_destroy(copy);
+            return NULL;
+        }
+        strcpy(copy->errstr,orig->errstr);
+    }
+    copy->error_log = orig->error_log;
+
+    copy->learning_rate = orig->learning_rate;
+    copy->learning_momentum = orig->learning_momentum;
+    copy->connection_rate = orig->connection_rate;
+    copy->network_type = orig->network_type;
+    copy->num_MSE = orig->num_MSE;
+    copy->MSE_value = orig->MSE_value;
+    copy->num_bit_fail = orig->num_bit_fail;
+    copy->bit_fail_limit = orig->bit_fail_limit;
+    copy->train_error_function = orig->train_error_function;
+    copy->train_stop_function = orig->train_stop_function;
+	copy->training_algorithm = orig->training_algorithm;
+	copy->activation_approximation = orig->activation_approximation;
+	copy->num_threads = orig->num_threads;
+	copy->batch_size = orig->batch_size;
+    copy->callback = orig->callback;
+	copy->user_data = orig->user_data;
+#ifndef FIXEDFANN
+    copy->cascade_output_change_fraction = orig->cascade_output_change_fraction;
+    copy->cascade_output_stagnation_epochs = orig->cascade_output_stagnation_epochs;
+    copy->cascade_candidate_change_fraction = orig->cascade_candidate_change_fraction;
+    copy->cascade_candidate_stagnation_epochs = orig->cascade_candidate_stagnation_epochs;
+    copy->cascade_best_candidate = orig->cascade_best_candidate;
+    copy->cascade_candidate_limit = orig->cascade_candidate_limit;
+    copy->cascade_weight_multiplier = orig->cascade_weight_multiplier;
+    copy->cascade_max_out_epochs = orig->cascade_max_out_epochs;
+    copy->cascade_max_cand_epochs = orig->cascade_max_cand_epochs;
+
+   /* copy cascade activation functions */
+    copy->cascade_activation_functions_count = orig->cascade_activation_functions_count;
+    copy->cascade_activation_functions = (enum fann_activationfunc_enum *)realloc(copy->cascade_activation_functions,
+        copy->cascade_activation_functions_count * sizeof(enum fann_activationfunc_enum));
+    if(copy->cascade_activation_functions == NULL)
+    {
+        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
+        fann_destroy(copy);
+        return NULL;
+    }
+    memcpy(copy->cascade_activation_functions,orig->cascade_activation_functions,
+            copy->cascade_activation_functions_count * sizeof(enum fann_activationfunc_enum));
+
+    /* copy cascade activation steepnesses */
+    copy->cascade_activation_steepnesses_count = orig->cascade_activation_steepnesses_count;
+    copy->cascade_activation_steepnesses = (fann_type *)realloc(copy->cascade_activation_steepnesses, copy->cascade_activation_steepnesses_count * sizeof(fann_type));
+    if(copy->cascade_activation_steepnesses == NULL)
+    {
+        fann_error((struct fann_error*)orig, FANN_E_CANT_ALLOCATE_MEM);
+        fann_destroy(copy);
+        return NULL;
+    }
+    memcpy(copy->cascade_activation_steepnesses,orig->cascade_activation_steepnesses,copy->cascade_activation_steepnesses_count * sizeof(fann_type));
+
+    copy->cascade_num_candidate_groups = orig->cascade_num_candidate_groups;
+
+    /* copy candidate scores, if used */
+    if (orig->cascade_candidate_scores == NULL)
+    {
+        copy->cascade_candidate_scores = NULL;
+    }
+    else
+    {
+        copy->cascade_candidate_scores =
+            (fann_type *) malloc(fann_get_cascade_num_candidates(copy) * sizeof(fann_type));
+        if(copy->cascade_candidate_scores == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->cascade_candidate_scores,orig->cascade_candidate_scores,fann_get_cascade_num_candidates(copy) * sizeof(fann_type));
+    }
+#endif /* FIXEDFANN */
+
+    copy->quickprop_decay = orig->quickprop_decay;
+    copy->quickprop_mu = orig->quickprop_mu;
+    copy->rprop_increase_factor = orig->rprop_increase_factor;
+    copy->rprop_decrease_factor = orig->rprop_decrease_factor;
+    copy->rprop_delta_min = orig->rprop_delta_min;
+    copy->rprop_delta_max = orig->rprop_delta_max;
+    copy->rprop_delta_zero = orig->rprop_delta_zero;
+    copy->adam_beta1 = orig->adam_beta1;
+    copy->adam_beta2 = orig->adam_beta2;
+    copy->adam_epsilon = orig->adam_epsilon;
+    copy->adam_weight_decay = orig->adam_weight_decay;
+    copy->adam_timestep = orig->adam_timestep;
+
+    /* user_data is not deep copied.  user should use fann_copy_with_user_data() for that */
+    copy->user_data = orig->user_data;
+
+#ifdef FIXEDFANN
+    copy->decimal_point = orig->decimal_point;
+    copy->multiplier = orig->multiplier;
+    memcpy(copy->sigmoid_results,orig->sigmoid_results,6*sizeof(fann_type));
+    memcpy(copy->sigmoid_values,orig->sigmoid_values,6*sizeof(fann_type));
+    memcpy(copy->sigmoid_symmetric_results,orig->sigmoid_symmetric_results,6*sizeof(fann_type));
+    memcpy(copy->sigmoid_symmetric_values,orig->sigmoid_symmetric_values,6*sizeof(fann_type));
+#endif
+
+
+    /* copy layer sizes, prepare for fann_allocate_neurons */
+    for (orig_layer_it = orig->first_layer, copy_layer_it = copy->first_layer;
+            orig_layer_it != orig->last_layer; orig_layer_it++, copy_layer_it++)
+    {
+        layer_size = (unsigned int)(orig_layer_it->last_neuron - orig_layer_it->first_neuron);
+        copy_layer_it->first_neuron = NULL;
+        copy_layer_it->last_neuron = copy_layer_it->first_neuron + layer_size;
+        copy->total_neurons += layer_size;
+    }
+    copy->num_input = orig->num_input;
+    copy->num_output = orig->num_output;
+
+
+    /* copy scale parameters, when used */
+#ifndef FIXEDFANN
+    if (orig->scale_mean_in != NULL)
+    {
+        fann_allocate_scale(copy);
+        for (i=0; i < orig->num_input ; i++) {
+            copy->scale_mean_in[i] = orig->scale_mean_in[i];
+            copy->scale_deviation_in[i] = orig->scale_deviation_in[i];
+            copy->scale_new_min_in[i] = orig->scale_new_min_in[i];
+            copy->scale_factor_in[i] = orig->scale_factor_in[i];
+        }
+        for (i=0; i < orig->num_output ; i++) {
+            copy->scale_mean_out[i] = orig->scale_mean_out[i];
+            copy->scale_deviation_out[i] = orig->scale_deviation_out[i];
+            copy->scale_new_min_out[i] = orig->scale_new_min_out[i];
+            copy->scale_factor_out[i] = orig->scale_factor_out[i];
+        }
+    }
+#endif
+
+    /* copy the neurons */
+    fann_allocate_neurons(copy);
+    if (copy->errno_f == FANN_E_CANT_ALLOCATE_MEM)
+    {
+        fann_destroy(copy);
+        return NULL;
+    }
+    layer_size = (unsigned int)((orig->last_layer-1)->last_neuron - (orig->last_layer-1)->first_neuron);
+    memcpy(copy->output,orig->output, layer_size * sizeof(fann_type));
+
+    last_neuron = (orig->last_layer - 1)->last_neuron;
+    for (orig_neuron_it = orig->first_layer->first_neuron, copy_neuron_it = copy->first_layer->first_neuron;
+            orig_neuron_it != last_neuron; orig_neuron_it++, copy_neuron_it++)
+    {
+        memcpy(copy_neuron_it,orig_neuron_it,sizeof(struct fann_neuron));
+    }
+    memcpy(copy->values, orig->values, copy->total_neurons * sizeof(fann_type));
+    memcpy(copy->sums, orig->sums, copy->total_neurons * sizeof(fann_type));
+ /* copy the connections */
+    copy->total_connections = orig->total_connections;
+    fann_allocate_connections(copy);
+    if (copy->errno_f == FANN_E_CANT_ALLOCATE_MEM)
+    {
+        fann_destroy(copy);
+        return NULL;
+    }
+
+    orig_first_neuron = orig->first_layer->first_neuron;
+    copy_first_neuron = copy->first_layer->first_neuron;
+    for (i=0; i < orig->total_connections; i++)
+    {
+        copy->weights[i] = orig->weights[i];
+        input_neuron = (unsigned int)(orig->connections[i] - orig_first_neuron);
+        copy->connections[i] = copy_first_neuron + input_neuron;
+    }
+
+    if (orig->train_slopes)
+    {
+        copy->train_slopes = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
+        if (copy->train_slopes == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->train_slopes,orig->train_slopes,copy->total_connections_allocated * sizeof(fann_type));
+    }
+
+    if (orig->prev_steps)
+    {
+        copy->prev_steps = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
+        if (copy->prev_steps == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->prev_steps, orig->prev_steps, copy->total_connections_allocated * sizeof(fann_type));
+    }
+
+    if (orig->prev_train_slopes)
+    {
+        copy->prev_train_slopes = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
+        if (copy->prev_train_slopes == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->prev_train_slopes,orig->prev_train_slopes, copy->total_connections_allocated * sizeof(fann_type));
+    }
+
+    if (orig->prev_weights_deltas)
+    {
+        copy->prev_weights_deltas = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
+        if(copy->prev_weights_deltas == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->prev_weights_deltas, orig->prev_weights_deltas,copy->total_connections_allocated * sizeof(fann_type));
+    }
+
+    if (orig->connection_mask)
+    {
+        copy->connection_mask = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
+        if(copy->connection_mask == NULL)
         {
             fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
             fann_destroy(copy);
             return NULL;
         }
-        memcpy(copy->train_slopes,orig->train_slopes,copy->total_connections_allocated * sizeof(fann_type));
+        memcpy(copy->connection_mask, orig->connection_mask, copy->total_connections_allocated * sizeof(fann_type));
+        if (fann_update_active_connections(copy) == -1)
+        {
+            fann_destroy(copy);
+            return NULL;
+        }
+    }
+
+#ifndef FIXEDFANN
+    if (orig->values_int8_scale)
+    {
+        copy->values_int8_scale = (float *) malloc(num_layers * sizeof(float));
+        if (copy->values_int8_scale == NULL)
+        {
+            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
+            fann_destroy(copy);
+            return NULL;
+        }
+        memcpy(copy->values_int8_scale, orig->values_int8_scale, num_layers * sizeof(float));
+    }
+
+    if (orig->precision != FANN_PRECISION_DEFAULT && fann_set_precision(copy, orig->precision) == -1)
+    {
+        fann_destroy(copy);
+        return NULL;
+    }
+#endif
+
+    return copy;
+}
+
+FANN_EXTERNAL void FANN_API fann_print_connections(struct fann *ann)
+{
+	struct fann_layer *layer_it;
+	struct fann_neuron *neuron_it;
+	unsigned int i;
+	int value;
+	char *neurons;
+	unsigned int num_neurons = fann_get_total_neurons(ann) - fann_get_num_output(ann);
+
+	neurons = (char *) malloc(num_neurons + 1);
+	if(neurons == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
+	neurons[num_neurons] = 0;
+
+	printf("Layer / Neuron ");
+	for(i = 0; i < num_neurons; i++)
+	{
+		printf("%d", i % 10);
+	}
+	printf("\n");
+
+	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+	{
+		for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++)
+		{
+
+			memset(neurons, (int) '.', num_neurons);
+			for(i = neuron_it->first_con; i < neuron_it->last_con; i++)
+			{
+				if(ann->weights[i] < 0)
+				{
+#ifdef FIXEDFANN
+					value = (int) ((ann->weights[i] / (double) ann->multiplier) - 0.5);
+#else
+					value = (int) ((ann->weights[i]) - 0.5);
+#endif
+					if(value < -25)
+						value = -25;
+					neurons[ann->connections[i] - ann->first_layer->first_neuron] = (char)('a' - value);
+				}
+				else
+				{
+#ifdef FIXEDFANN
+					value = (int) ((ann->weights[i] / (double) ann->multiplier) + 0.5);
+#else
+					value = (int) ((ann->weights[i]) + 0.5);
+#endif
+					if(value > 25)
+						value = 25;
+					neurons[ann->connections[i] - ann->first_layer->first_neuron] = (char)('A' + value);
+				}
+			}
+			printf("L %3d / N %4d %s\n", (int)(layer_it - ann->first_layer),
+				   (int)(neuron_it - ann->first_layer->first_neuron), neurons);
+		}
+	}
+
+	free(neurons);
+}
+
+/* Initialize the weights using Widrow + Nguyen's algorithm.
+*/
+FANN_EXTERNAL void FANN_API fann_init_weights(struct fann *ann, struct fann_train_data *train_data)
+{
+	fann_type smallest_inp, largest_inp;
+	unsigned int dat = 0, elem, num_connect, num_hidden_neurons;
+	struct fann_layer *layer_it;
+	struct fann_neuron *neuron_it, *last_neuron, *bias_neuron;
+
+#ifdef FIXEDFANN
+	unsigned int multiplier = ann->multiplier;
+#endif
+	float scale_factor;
+
+	for(smallest_inp = largest_inp = train_data->input[0][0]; dat < train_data->num_data; dat++)
+	{
+		for(elem = 0; elem < train_data->num_input; elem++)
+		{
+			if(train_data->input[dat][elem] < smallest_inp)
+				smallest_inp = train_data->input[dat][elem];
+			if(train_data->input[dat][elem] > largest_inp)
+				largest_inp = train_data->input[dat][elem];
+		}
+	}
+
+	num_hidden_neurons = (unsigned int)(
+		ann->total_neurons - (ann->num_input + ann->num_output +
+							  (ann->last_layer - ann->first_layer)));
+	scale_factor =
+		(float) (pow
+				 ((double) (0.7f * (double) num_hidden_neurons),
+				  (double) (1.0f / (double) ann->num_input)) / (double) (largest_inp -
+																		 smallest_inp));
+
+#ifdef DEBUG
+	printf("Initializing weights with scale factor %f\n", scale_factor);
+#endif
+	bias_neuron = ann->first_layer->last_neuron - 1;
+	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+	{
+		last_neuron = layer_it->last_neuron;
+
+		if(ann->network_type == FANN_NETTYPE_LAYER)
+		{
+			bias_neuron = (layer_it - 1)->last_neuron - 1;
+		}
+
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			for(num_connect = neuron_it->first_con; num_connect < neuron_it->last_con;
+				num_connect++)
+			{
+				if(bias_neuron == ann->connections[num_connect])
+				{
+#ifdef FIXEDFANN
+					ann->weights[num_connect] =
+						(fann_type) fann_rand(-scale_factor, scale_factor * multiplier);
+#else
+					ann->weights[num_connect] = (fann_type) fann_rand(-scale_factor, scale_factor);
+#endif
+				}
+				else
+				{
+#ifdef FIXEDFANN
+					ann->weights[num_connect] = (fann_type) fann_rand(0, scale_factor * multiplier);
+#else
+					ann->weights[num_connect] = (fann_type) fann_rand(0, scale_factor);
+#endif
+				}
+			}
+		}
+	}
+	fann_apply_connection_mask(ann, 0, ann->total_connections);
+	ann->precision_stale = 1;
+
+#ifndef FIXEDFANN
+	if(ann->prev_train_slopes != NULL)
+	{
+		fann_clear_train_arrays(ann);
+	}
+#endif
+}
+
+FANN_EXTERNAL void FANN_API fann_print_parameters(struct fann *ann)
+{
+	struct fann_layer *layer_it;
+#ifndef FIXEDFANN
+	unsigned int i;
+#endif
+
+	printf("Input layer                          :%4d neurons, 1 bias\n", ann->num_input);
+	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer - 1; layer_it++)
+	{
+		if(ann->network_type == FANN_NETTYPE_SHORTCUT)
+		{
+			printf("  Hidden layer                       :%4d neurons, 0 bias\n",
+				   (int)(layer_it->last_neuron - layer_it->first_neuron));
+		}
+		else
+		{
+			printf("  Hidden layer                       :%4d neurons, 1 bias\n",
+				   (int)(layer_it->last_neuron - layer_it->first_neuron - 1));
+		}
+	}
+	printf("Output layer                         :%4d neurons\n", ann->num_output);
+	printf("Total neurons and biases             :%4d\n", fann_get_total_neurons(ann));
+	printf("Total connections                    :%4d\n", ann->total_connections);
+	printf("Connection rate                      :%8.3f\n", ann->connection_rate);
+	printf("Network type                         :   %s\n", FANN_NETTYPE_NAMES[ann->network_type]);
+	printf("Precision                            :   %s\n", FANN_PRECISION_NAMES[ann->precision]);
+	printf("Activation approximation             :   %s\n", FANN_APPROXIMATION_NAMES[ann->activation_approximation]);
+#ifdef FIXEDFANN
+	printf("Decimal point                        :%4d\n", ann->decimal_point);
+	printf("Multiplier                           :%4d\n", ann->multiplier);
+#else
+	printf("Training algorithm                   :   %s\n", FANN_TRAIN_NAMES[ann->training_algorithm]);
+	printf("Batch size                           :%4d\n", ann->batch_size);
+	printf("Training error function              :   %s\n", FANN_ERRORFUNC_NAMES[ann->train_error_function]);
+	printf("Training stop function               :   %s\n", FANN_STOPFUNC_NAMES[ann->train_stop_function]);
+#endif
+#ifdef FIXEDFANN
+	printf("Bit fail limit                       :%4d\n", ann->bit_fail_limit);
+#else
+	printf("Bit fail limit                       :%8.3f\n", ann->bit_fail_limit);
+	printf("Learning rate                        :%8.3f\n", ann->learning_rate);
+	printf("Learning momentum                    :%8.3f\n", ann->learning_momentum);
+	printf("Quickprop decay                      :%11.6f\n", ann->quickprop_decay);
+	printf("Quickprop mu                         :%8.3f\n", ann->quickprop_mu);
+	printf("RPROP increase factor                :%8.3f\n", ann->rprop_increase_factor);
+	printf("RPROP decrease factor                :%8.3f\n", ann->rprop_decrease_factor);
+	printf("RPROP delta min                      :%8.3f\n", ann->rprop_delta_min);
+	printf("RPROP delta max                      :%8.3f\n", ann->rprop_delta_max);
+	printf("Adam beta1                           :%8.3f\n", ann->adam_beta1);
+	printf("Adam beta2                           :%8.3f\n", ann->adam_beta2);
+	printf("Adam epsilon                         :%11.3e\n", ann->adam_epsilon);
+	printf("Adam weight decay                    :%11.6f\n", ann->adam_weight_decay);
+	printf("Cascade output change fraction       :%11.6f\n", ann->cascade_output_change_fraction);
+	printf("Cascade candidate change fraction    :%11.6f\n", ann->cascade_candidate_change_fraction);
+	printf("Cascade output stagnation epochs     :%4d\n", ann->cascade_output_stagnation_epochs);
+	printf("Cascade candidate stagnation epochs  :%4d\n", ann->cascade_candidate_stagnation_epochs);
+	printf("Cascade max output epochs            :%4d\n", ann->cascade_max_out_epochs);
+	printf("Cascade min output epochs            :%4d\n", ann->cascade_min_out_epochs);
+	printf("Cascade max candidate epochs         :%4d\n", ann->cascade_max_cand_epochs);
+	printf("Cascade min candidate epochs         :%4d\n", ann->cascade_min_cand_epochs);
+	printf("Cascade weight multiplier            :%8.3f\n", ann->cascade_weight_multiplier);
+	printf("Cascade candidate limit              :%8.3f\n", ann->cascade_candidate_limit);
+	for(i = 0; i < ann->cascade_activation_functions_count; i++)
+		printf("Cascade activation functions[%d]      :   %s\n", i,
+			FANN_ACTIVATIONFUNC_NAMES[ann->cascade_activation_functions[i]]);
+	for(i = 0; i < ann->cascade_activation_steepnesses_count; i++)
+		printf("Cascade activation steepnesses[%d]    :%8.3f\n", i,
+			ann->cascade_activation_steepnesses[i]);
+
+	printf("Cascade candidate groups             :%4d\n", ann->cascade_num_candidate_groups);
+	printf("Cascade no. of candidates            :%4d\n", fann_get_cascade_num_candidates(ann));
+
+	/* TODO: dump scale parameters */
+#endif
+}
+
+FANN_GET(unsigned int, num_input)
+FANN_GET(unsigned int, num_output)
+
+FANN_EXTERNAL unsigned int FANN_API fann_get_total_neurons(struct fann *ann)
+{
+	if(ann->network_type)
+	{
+		return ann->total_neurons;
+	}
+	else
+	{
+		/* -1, because there is always an unused bias neuron in the last layer */
+		return ann->total_neurons - 1;
+	}
+}
+
+FANN_GET(unsigned int, total_connections)
+
+FANN_EXTERNAL enum fann_nettype_enum FANN_API fann_get_network_type(struct fann *ann)
+{
+    /* Currently two types: LAYER = 0, SHORTCUT = 1 */
+    /* Enum network_types must be set to match the return values  */
+    return ann->network_type;
+}
+
+FANN_EXTERNAL float FANN_API fann_get_connection_rate(struct fann *ann)
+{
+    return ann->connection_rate;
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_get_num_layers(struct fann *ann)
+{
+    return (unsigned int)(ann->last_layer - ann->first_layer);
+}
+
+FANN_EXTERNAL void FANN_API fann_get_layer_array(struct fann *ann, unsigned int *layers)
+{
+    struct fann_layer *layer_it;
+
+    for (layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++) {
+        unsigned int count = (unsigned int)(layer_it->last_neuron - layer_it->first_neuron);
+        /* Remove the bias from the count of neurons. */
+        switch (fann_get_network_type(ann)) {
+            case FANN_NETTYPE_LAYER: {
+                --count;
+                break;
+            }
+            case FANN_NETTYPE_SHORTCUT: {
+                /* The bias in the first layer is reused for all layers */
+                if (layer_it == ann->first_layer)
+                    --count;
+                break;
+            }
+            default: {
+                /* Unknown network type, assume no bias present  */
+                break;
+            }
+        }
+        *layers++ = count;
+    }
+}
+
+FANN_EXTERNAL void FANN_API fann_get_bias_array(struct fann *ann, unsigned int *bias)
+{
+    struct fann_layer *layer_it;
+
+    for (layer_it = ann->first_layer; layer_it != ann->last_layer; ++layer_it, ++bias) {
+        switch (fann_get_network_type(ann)) {
+            case FANN_NETTYPE_LAYER: {
+                /* Report one bias in each layer except the last */
+                if (layer_it != ann->last_layer-1)
+                    *bias = 1;
+                else
+                    *bias = 0;
+                break;
+            }
+            case FANN_NETTYPE_SHORTCUT: {
+                /* The bias in the first layer is reused for all layers */
+                if (layer_it == ann->first_layer)
+                    *bias = 1;
+                else
+                    *bias = 0;
+                break;
+            }
+            default: {
+                /* Unknown network type, assume no bias present  */
+                *bias = 0;
+                break;
+            }
+        }
+    }
+}
+
+FANN_EXTERNAL void FANN_API fann_get_connection_array(struct fann *ann, struct fann_connection *connections)
+{
+    struct fann_neuron *first_neuron;
+    struct fann_layer *layer_it;
+    struct fann_neuron *neuron_it;
+    unsigned int idx;
+    unsigned int source_index;
+    unsigned int destination_index;
+
+    first_neuron = ann->first_layer->first_neuron;
+
+    source_index = 0;
+    destination_index = 0;
+
+    /* The following assumes that the last unused bias has no connections */
+
+    /* for each layer */
+    for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++){
+        /* for each neuron */
+        for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++){
+            /* for each connection */
+            for (idx = neuron_it->first_con; idx < neuron_it->last_con; idx++){
+                /* Assign the source, destination and weight */
+                connections->from_neuron = (unsigned int)(ann->connections[source_index] - first_neuron);
+                connections->to_neuron = destination_index;
+                connections->weight = ann->weights[source_index];
+
+                connections++;
+                source_index++;
+            }
+            destination_index++;
+        }
+    }
+}
+
+FANN_EXTERNAL void FANN_API fann_set_weight_array(struct fann *ann,
+    struct fann_connection *connections, unsigned int num_connections)
+{
+    unsigned int idx;
+
+    for (idx = 0; idx < num_connections; idx++) {
+        fann_set_weight(ann, connections[idx].from_neuron,
+            connections[idx].to_neuron, connections[idx].weight);
+    }
+}
+
+FANN_EXTERNAL void FANN_API fann_set_weight(struct fann *ann,
+    unsigned int from_neuron, unsigned int to_neuron, fann_type weight)
+{
+    struct fann_neuron *first_neuron;
+    struct fann_layer *layer_it;
+    struct fann_neuron *neuron_it;
+    unsigned int idx;
+    unsigned int source_index;
+    unsigned int destination_index;
+
+    first_neuron = ann->first_layer->first_neuron;
+
+    source_index = 0;
+    destination_index = 0;
+
+    /* Find the connection, simple brute force search through the network
+       for one or more connections that match to minimize datastructure dependencies.
+       Nothing is done if the connection does not already exist in the network. */
+
+    /* for each layer */
+    for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++){
+        /* for each neuron */
+        for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++){
+            /* for each connection */
+            for (idx = neuron_it->first_con; idx < neuron_it->last_con; idx++){
+                /* If the source and destination neurons match, assign the weight */
+                if (((int)from_neuron == ann->connections[source_index] - first_neuron) &&
+                    (to_neuron == destination_index))
+                {
+                    ann->weights[source_index] = weight;
+                    ann->precision_stale = 1;
+                }
+                source_index++;
+            }
+            destination_index++;
+        }
     }
+}
+
+FANN_EXTERNAL void FANN_API fann_get_weights(struct fann *ann, fann_type *weights)
+{
+	memcpy(weights, ann->weights, sizeof(fann_type)*ann->total_connections);
+}
+
+FANN_EXTERNAL void FANN_API fann_set_weights(struct fann *ann, fann_type *weights)
+{
+	memcpy(ann->weights, weights, sizeof(fann_type)*ann->total_connections);
+	fann_apply_connection_mask(ann, 0, ann->total_connections);
+	ann->precision_stale = 1;
+}
+
+FANN_EXTERNAL void FANN_API fann_rewind_weights(struct fann *ann, const fann_type *weights)
+{
+	memcpy(ann->weights, weights, sizeof(fann_type)*ann->total_connections);
+	fann_apply_connection_mask(ann, 0, ann->total_connections);
+	ann->precision_stale = 1;
+
+#ifndef FIXEDFANN
+	if(ann->prev_train_slopes != NULL)
+	{
+		fann_clear_train_arrays(ann);
+	}
+	if(ann->prev_weights_deltas != NULL)
+	{
+		memset(ann->prev_weights_deltas, 0, ann->total_connections_allocated * sizeof(fann_type));
+	}
+#endif
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_prune_connections(struct fann *ann, fann_type threshold)
+{
+	unsigned int i;
+
+	if(ann->connection_mask == NULL && fann_allocate_connection_mask(ann) == -1)
+		return ann->total_connections;
+
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		if(fann_abs(ann->weights[i]) < threshold)
+		{
+			ann->connection_mask[i] = 0;
+			ann->weights[i] = 0;
+		}
+	}
+	ann->precision_stale = 1;
+
+	fann_update_active_connections(ann);
+	return ann->total_active_connections;
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_prune_smallest_connections(struct fann *ann, float sparsity)
+{
+	if(sparsity <= 0)
+		return fann_get_total_active_connections(ann);
+
+	if(ann->connection_mask == NULL && fann_allocate_connection_mask(ann) == -1)
+		return ann->total_connections;
+
+	fann_prune_smallest_in_range(ann, 0, ann->total_connections, sparsity, NULL);
+	ann->precision_stale = 1;
+
+	fann_update_active_connections(ann);
+	return ann->total_active_connections;
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_prune_smallest_layer_connections(struct fann *ann,
+																		  unsigned int layer,
+																		  float sparsity,
+																		  int keep_bias)
+{
+	struct fann_layer *layer_it = ann->first_layer + layer;
+	unsigned char *bias_flags = NULL;
+
+	if(layer == 0 || layer_it >= ann->last_layer)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_INDEX_OUT_OF_BOUND, layer);
+		return fann_get_total_active_connections(ann);
+	}
+	if(sparsity <= 0)
+		return fann_get_total_active_connections(ann);
+
+	if(ann->connection_mask == NULL && fann_allocate_connection_mask(ann) == -1)
+		return ann->total_connections;
+	if(keep_bias && (bias_flags = fann_create_bias_flags(ann)) == NULL)
+		return fann_get_total_active_connections(ann);
+
+	fann_prune_smallest_in_range(ann, layer_it->first_neuron->first_con,
+								 (layer_it->last_neuron - 1)->last_con, sparsity, bias_flags);
+	fann_safe_free(bias_flags);
+	ann->precision_stale = 1;
+
+	fann_update_active_connections(ann);
+	return ann->total_active_connections;
+}
+
+FANN_EXTERNAL void FANN_API fann_init_pruning_schedule(struct fann_pruning_schedule *schedule,
+													   enum fann_pruning_schedule_enum type,
+													   float final_sparsity, unsigned int first_step,
+													   unsigned int last_step)
+{
+	schedule->schedule = type;
+	schedule->first_step = first_step;
+	schedule->last_step = last_step;
+	schedule->frequency = 1;
+	schedule->initial_sparsity = 0;
+	schedule->final_sparsity = final_sparsity;
+	schedule->layer_sparsity = NULL;
+	schedule->keep_bias = 0;
+	schedule->rewind_weights = NULL;
+	schedule->callback = NULL;
+	schedule->user_data = NULL;
+}
+
+FANN_EXTERNAL float FANN_API fann_get_scheduled_sparsity(const struct fann_pruning_schedule *schedule,
+														 unsigned int step)
+{
+	float initial = schedule->initial_sparsity;
+	float final = schedule->final_sparsity;
+	float progress;
+
+	if(step < schedule->first_step)
+		return initial;
+	if(step >= schedule->last_step)
+		return final;
+	progress = (float) (step - schedule->first_step) / (float) (schedule->last_step - schedule->first_step);
+
+	switch (schedule->schedule)
+	{
+	case FANN_PRUNING_CUBIC:
+		return final + (initial - final) * (1 - progress) * (1 - progress) * (1 - progress);
+	case FANN_PRUNING_EXPONENTIAL:
+		if(initial >= 1)
+			return 1;
+		return 1 - (1 - initial) * (float) pow((1 - final) / (1 - initial), progress);
+	case FANN_PRUNING_LINEAR:
+	default:
+		return initial + (final - initial) * progress;
+	}
+}
+
+FANN_EXTERNAL float FANN_API fann_prune_on_schedule(struct fann *ann,
+													const struct fann_pruning_schedule *schedule,
+													unsigned int step)
+{
+	float scheduled_sparsity, sparsity;
+	unsigned int kept, previously_kept;
+	unsigned int frequency = schedule->frequency > 0 ? schedule->frequency : 1;
+
+	if(step < schedule->first_step || step > schedule->last_step ||
+	   ((step - schedule->first_step) % frequency != 0 && step != schedule->last_step))
+	{
+		kept = fann_get_total_active_connections(ann);
+		return (float) (ann->total_connections - kept) / (float) ann->total_connections;
+	}
+
+	previously_kept = fann_get_total_active_connections(ann);
+	if(schedule->layer_sparsity == NULL && !schedule->keep_bias)
+	{
+		scheduled_sparsity = fann_get_scheduled_sparsity(schedule, step);
+		kept = fann_prune_smallest_connections(ann, scheduled_sparsity);
+	}
+	else
+	{
+		struct fann_pruning_schedule layer_schedule = *schedule;
+		struct fann_layer *layer_it;
+		unsigned int layer, num_connections;
+		float layer_sparsity;
+
+		scheduled_sparsity = 0;
+		kept = fann_get_total_active_connections(ann);
+		for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+		{
+			layer = (unsigned int) (layer_it - ann->first_layer);
+			if(schedule->layer_sparsity != NULL)
+				layer_schedule.final_sparsity = schedule->layer_sparsity[layer - 1];
+			layer_sparsity = fann_get_scheduled_sparsity(&layer_schedule, step);
+			num_connections = (layer_it->last_neuron - 1)->last_con - layer_it->first_neuron->first_con;
+			scheduled_sparsity += layer_sparsity * num_connections / ann->total_connections;
+			kept = fann_prune_smallest_layer_connections(ann, layer, layer_sparsity, schedule->keep_bias);
+		}
+	}
+	if(schedule->rewind_weights != NULL && kept < previously_kept)
+		fann_rewind_weights(ann, schedule->rewind_weights);
+	sparsity = (float) (ann->total_connections - kept) / (float) ann->total_connections;
+	if(schedule->callback != NULL)
+		schedule->callback(ann, step, scheduled_sparsity, sparsity, schedule->user_data);
+	return sparsity;
+}
+
+FANN_EXTERNAL int FANN_API fann_set_connection_mask(struct fann *ann, const unsigned char *mask)
+{
+	unsigned int i;
+
+	if(mask == NULL)
+	{
+		fann_safe_free(ann->connection_mask);
+		return fann_update_active_connections(ann);
+	}
+
+	if(ann->connection_mask == NULL && fann_allocate_connection_mask(ann) == -1)
+		return -1;
+
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		ann->connection_mask[i] = mask[i] != 0 ? 1 : 0;
+	}
+	fann_apply_connection_mask(ann, 0, ann->total_connections);
+	ann->precision_stale = 1;
+
+	return fann_update_active_connections(ann);
+}
+
+FANN_EXTERNAL void FANN_API fann_get_connection_mask(struct fann *ann, unsigned char *mask)
+{
+	unsigned int i;
+
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		mask[i] = ann->connection_mask == NULL || ann->connection_mask[i] != 0;
+	}
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_get_total_active_connections(struct fann *ann)
+{
+	return ann->connection_mask == NULL ? ann->total_connections : ann->total_active_connections;
+}
+
+/* INTERNAL FUNCTION
+   Allocates connection_mask with every connection kept.
+ */
+int fann_allocate_connection_mask(struct fann *ann)
+{
+	unsigned int i;
+
+	ann->connection_mask = (fann_type *) malloc(ann->total_connections_allocated * sizeof(fann_type));
+	if(ann->connection_mask == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+
+	for(i = 0; i != ann->total_connections_allocated; i++)
+	{
+		ann->connection_mask[i] = 1;
+	}
+	ann->total_active_connections = ann->total_connections;
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Counts the connections kept by connection_mask and lists them in active_offsets and
+   active_first when the network is fully connected and at most one connection in five is
+   kept. With random pruning, that is about where going through the kept connections one
+   by one gets faster than multiplying all the weights. The lists are freed otherwise.
+ */
+int fann_update_active_connections(struct fann *ann)
+{
+	struct fann_neuron *neuron_it;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	struct fann_neuron *last_neuron = (ann->last_layer - 1)->last_neuron;
+	unsigned int i, num_active = 0;
+
+	if(ann->connection_mask != NULL)
+	{
+		for(i = 0; i != ann->total_connections; i++)
+		{
+			if(ann->connection_mask[i] != 0)
+				num_active++;
+		}
+	}
+	ann->total_active_connections = num_active;
+
+	if(ann->connection_mask == NULL || ann->connection_rate < 1 || num_active * 5 > ann->total_connections)
+	{
+		fann_safe_free(ann->active_offsets);
+		fann_safe_free(ann->active_first);
+		return 0;
+	}
+
+	if(ann->active_offsets == NULL)
+	{
+		ann->active_offsets = (unsigned int *) malloc(ann->total_connections_allocated * sizeof(unsigned int));
+		ann->active_first = (unsigned int *) malloc((ann->total_neurons + 1) * sizeof(unsigned int));
+		if(ann->active_offsets == NULL || ann->active_first == NULL)
+		{
+			fann_safe_free(ann->active_offsets);
+			fann_safe_free(ann->active_first);
+			fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+			return -1;
+		}
+	}
+
+	num_active = 0;
+	for(neuron_it = first_neuron; neuron_it != last_neuron; neuron_it++)
+	{
+		ann->active_first[neuron_it - first_neuron] = num_active;
+		for(i = neuron_it->first_con; i != neuron_it->last_con; i++)
+		{
+			if(ann->connection_mask[i] != 0)
+				ann->active_offsets[num_active++] = i - neuron_it->first_con;
+		}
+	}
+	ann->active_first[ann->total_neurons] = num_active;
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Sets the weights of the pruned connections among first_weight to past_end - 1 back to 0,
+   after a training algorithm updated all of them.
+ */
+void fann_apply_connection_mask(struct fann *ann, unsigned int first_weight, unsigned int past_end)
+{
+	fann_type *weights = ann->weights;
+	const fann_type *mask = ann->connection_mask;
+	unsigned int i;
+
+	if(mask == NULL)
+		return;
+
+	for(i = first_weight; i != past_end; i++)
+	{
+		weights[i] *= mask[i];
+	}
+}
+
+/* Number of bins of the histogram of fann_prune_smallest_in_range, one per value of the top
+   16 bits of the keys: the exponent and the 4 leading mantissa bits of the weights.
+ */
+#define FANN_MAGNITUDE_BINS 65536
+
+/* INTERNAL FUNCTION
+   Returns a key that sorts like the absolute value of weight: without its sign bit, the bits
+   of an IEEE float grow with its value. The sign is cleared on the bits rather than with
+   fann_abs, which turns 0 into -0. Float keys are shifted to the top of the 64 bits, so the
+   top 16 bits are the exponent and the leading mantissa bits for both fann_types.
+ */
+uint64_t fann_magnitude_key(fann_type weight)
+{
+#ifdef DOUBLEFANN
+	uint64_t bits;
+
+	memcpy(&bits, &weight, sizeof(bits));
+	return bits & 0x7fffffffffffffffULL;
+#else
+	uint32_t bits;
+
+	memcpy(&bits, &weight, sizeof(bits));
+	return (uint64_t) (bits & 0x7fffffffU) << 32;
+#endif
+}
+
+/* INTERNAL FUNCTION
+   Returns the key that would be at index rank if keys were sorted, reordering keys around it
+   (quickselect, linear time on average).
+ */
+uint64_t fann_select_key(uint64_t *keys, int count, int rank)
+{
+	int left = 0, right = count - 1, i, j;
+	uint64_t pivot, tmp;
+
+	while(left < right)
+	{
+		pivot = keys[left + (right - left) / 2];
+		i = left;
+		j = right;
+		while(i <= j)
+		{
+			while(keys[i] < pivot)
+				i++;
+			while(keys[j] > pivot)
+				j--;
+			if(i <= j)
+			{
+				tmp = keys[i];
+				keys[i] = keys[j];
+				keys[j] = tmp;
+				i++;
+				j--;
+			}
+		}
+		/* keys[left..j] <= pivot, keys[j+1..i-1] == pivot, keys[i..right] >= pivot */
+		if(rank <= j)
+			right = j;
+		else if(rank >= i)
+			left = i;
+		else
+			return keys[rank];
+	}
+	return keys[rank];
+}
+
+/* INTERNAL FUNCTION
+   Returns an array of total_neurons flags that are 1 for the bias neurons, or NULL if it could
+   not be allocated. The bias neuron is the last neuron of every layer but the output layer, and
+   only of the input layer in shortcut networks.
+ */
+unsigned char *fann_create_bias_flags(struct fann *ann)
+{
+	struct fann_layer *layer_it;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned char *bias_flags = (unsigned char *) calloc(ann->total_neurons, sizeof(unsigned char));
+
+	if(bias_flags == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return NULL;
+	}
+	for(layer_it = ann->first_layer; layer_it != ann->last_layer - 1; layer_it++)
+	{
+		bias_flags[(layer_it->last_neuron - 1) - first_neuron] = 1;
+		if(ann->network_type == FANN_NETTYPE_SHORTCUT)
+			break;
+	}
+	return bias_flags;
+}
+
+/* INTERNAL FUNCTION
+   Prunes the kept connections among first_con to past_con - 1 with the smallest weights in
+   absolute value until sparsity of them are pruned, counting the ones already pruned. When
+   exempt_neurons is not NULL, the connections from the neurons it flags are left out: they
+   are never pruned and do not count in the sparsity. connection_mask must be allocated.
+
+   The first pass counts the keys of the kept weights in a histogram of their top 16 bits,
+   which locates the bin of the threshold and how many weights are below it. The second pass
+   gathers the keys of that bin, where the threshold is selected, and the last one prunes the
+   weights below the threshold and as many of those equal to it as are still missing.
+   Returns -1 if the buffers could not be allocated.
+ */
+int fann_prune_smallest_in_range(struct fann *ann, unsigned int first_con, unsigned int past_con,
+								 float sparsity, const unsigned char *exempt_neurons)
+{
+	fann_type *weights = ann->weights;
+	fann_type *mask = ann->connection_mask;
+	struct fann_neuron **connections = ann->connections;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int *histogram;
+	uint64_t *candidates, key, threshold;
+	unsigned int i, bin, num_prunable, num_pruned, num_kept, below, num_candidates, num_less, num_equal;
+	int num_threads = 1;
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	int thread;
+	unsigned int *thread_histogram;
+
+	/* each thread adds a histogram, which only pays off when it has many more weights than bins */
+	num_threads = ann->num_threads != 0 ? (int) ann->num_threads : omp_get_max_threads();
+	if(num_threads > (int) ((past_con - first_con) / (4 * FANN_MAGNITUDE_BINS)))
+		num_threads = (int) ((past_con - first_con) / (4 * FANN_MAGNITUDE_BINS));
+	if(num_threads < 1)
+		num_threads = 1;
+#endif
+
+	num_prunable = past_con - first_con;
+	if(exempt_neurons != NULL)
+	{
+		num_prunable = 0;
+		for(i = first_con; i != past_con; i++)
+		{
+			if(!exempt_neurons[connections[i] - first_neuron])
+				num_prunable++;
+		}
+	}
+	if(sparsity >= 1)
+		num_pruned = num_prunable;
+	else
+		num_pruned = (unsigned int) ((double) sparsity * num_prunable + 0.5);
+	if(num_pruned == 0)
+		return 0;
+
+	/* a connection that is kept and not exempt */
+#define fann_is_prunable(i) \
+	(mask[i] != 0 && (exempt_neurons == NULL || !exempt_neurons[connections[i] - first_neuron]))
+
+	histogram = (unsigned int *) calloc((size_t) num_threads * FANN_MAGNITUDE_BINS, sizeof(unsigned int));
+	if(histogram == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	if(num_threads > 1)
+	{
+		#pragma omp parallel for num_threads(num_threads) schedule(static, 1) private(i, thread_histogram)
+		for(thread = 0; thread < num_threads; thread++)
+		{
+			unsigned int first = first_con + (unsigned int) ((unsigned long) (past_con - first_con) * thread / num_threads);
+			unsigned int past = first_con + (unsigned int) ((unsigned long) (past_con - first_con) * (thread + 1) / num_threads);
+
+			thread_histogram = histogram + (size_t) thread * FANN_MAGNITUDE_BINS;
+			for(i = first; i < past; i++)
+			{
+				if(fann_is_prunable(i))
+					thread_histogram[fann_magnitude_key(weights[i]) >> 48]++;
+			}
+		}
+		for(thread = 1; thread < num_threads; thread++)
+		{
+			thread_histogram = histogram + (size_t) thread * FANN_MAGNITUDE_BINS;
+			for(bin = 0; bin != FANN_MAGNITUDE_BINS; bin++)
+				histogram[bin] += thread_histogram[bin];
+		}
+	}
+	else
+#endif
+	{
+		for(i = first_con; i != past_con; i++)
+		{
+			if(fann_is_prunable(i))
+				histogram[fann_magnitude_key(weights[i]) >> 48]++;
+		}
+	}
+
+	num_kept = 0;
+	for(bin = 0; bin != FANN_MAGNITUDE_BINS; bin++)
+		num_kept += histogram[bin];
+
+	/* the pruned connections count towards num_pruned */
+	if(num_pruned <= num_prunable - num_kept)
+	{
+		free(histogram);
+		return 0;
+	}
+	num_pruned -= num_prunable - num_kept;
+	if(num_pruned > num_kept)
+		num_pruned = num_kept;
+
+	/* the bin of the num_pruned-th smallest kept weight */
+	below = 0;
+	for(bin = 0; below + histogram[bin] < num_pruned; bin++)
+		below += histogram[bin];
+	num_candidates = histogram[bin];
+	free(histogram);
+
+	candidates = (uint64_t *) malloc(num_candidates * sizeof(uint64_t));
+	if(candidates == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	num_candidates = 0;
+	for(i = first_con; i != past_con; i++)
+	{
+		if(fann_is_prunable(i))
+		{
+			key = fann_magnitude_key(weights[i]);
+			if((key >> 48) == bin)
+				candidates[num_candidates++] = key;
+		}
+	}
+
+	threshold = fann_select_key(candidates, (int) num_candidates, (int) (num_pruned - below - 1));
+	num_less = 0;
+	for(i = 0; i != num_candidates; i++)
+	{
+		if(candidates[i] < threshold)
+			num_less++;
+	}
+	free(candidates);
+
+	/* prunes the weights below the threshold and the first ones equal to it */
+	num_equal = num_pruned - below - num_less;
+	for(i = first_con; i != past_con; i++)
+	{
+		if(!fann_is_prunable(i))
+			continue;
+		key = fann_magnitude_key(weights[i]);
+		if(key < threshold || (key == threshold && num_equal != 0))
+		{
+			if(key == threshold)
+				num_equal--;
+			mask[i] = 0;
+			weights[i] = 0;
+		}
+	}
+	return 0;
+#undef fann_is_prunable
+}
+
+FANN_GET_SET(void *, user_data)
+
+#ifdef FIXEDFANN
+
+FANN_GET(unsigned int, decimal_point)
+FANN_GET(unsigned int, multiplier)
+
+/* INTERNAL FUNCTION
+   Adjust the steepwise functions (if used)
+*/
+void fann_update_stepwise(struct fann *ann)
+{
+	unsigned int i = 0;
+
+	/* Calculate the parameters for the stepwise linear
+	 * sigmoid function fixed point.
+	 * Using a rewritten sigmoid function.
+	 * results 0.005, 0.05, 0.25, 0.75, 0.95, 0.995
+	 */
+	ann->sigmoid_results[0] = fann_max((fann_type) (ann->multiplier / 200.0 + 0.5), 1);
+	ann->sigmoid_results[1] = fann_max((fann_type) (ann->multiplier / 20.0 + 0.5), 1);
+	ann->sigmoid_results[2] = fann_max((fann_type) (ann->multiplier / 4.0 + 0.5), 1);
+	ann->sigmoid_results[3] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 4.0 + 0.5), ann->multiplier - 1);
+	ann->sigmoid_results[4] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 20.0 + 0.5), ann->multiplier - 1);
+	ann->sigmoid_results[5] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 200.0 + 0.5), ann->multiplier - 1);
+
+	ann->sigmoid_symmetric_results[0] = fann_max((fann_type) ((ann->multiplier / 100.0) - ann->multiplier - 0.5),
+				                                 (fann_type) (1 - (fann_type) ann->multiplier));
+	ann->sigmoid_symmetric_results[1] =	fann_max((fann_type) ((ann->multiplier / 10.0) - ann->multiplier - 0.5),
+				                                 (fann_type) (1 - (fann_type) ann->multiplier));
+	ann->sigmoid_symmetric_results[2] =	fann_max((fann_type) ((ann->multiplier / 2.0) - ann->multiplier - 0.5),
+                                				 (fann_type) (1 - (fann_type) ann->multiplier));
+	ann->sigmoid_symmetric_results[3] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 2.0 + 0.5),
+				 							     ann->multiplier - 1);
+	ann->sigmoid_symmetric_results[4] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 10.0 + 0.5),
+				 							     ann->multiplier - 1);
+	ann->sigmoid_symmetric_results[5] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 100.0 + 1.0),
+				 							     ann->multiplier - 1);
+
+	for(i = 0; i < 6; i++)
+	{
+		ann->sigmoid_values[i] =
+			(fann_type) (((log(ann->multiplier / (float) ann->sigmoid_results[i] - 1) *
+						   (float) ann->multiplier) / -2.0) * (float) ann->multiplier);
+		ann->sigmoid_symmetric_values[i] =
+			(fann_type) (((log
+						   ((ann->multiplier -
+							 (float) ann->sigmoid_symmetric_results[i]) /
+							((float) ann->sigmoid_symmetric_results[i] +
+							 ann->multiplier)) * (float) ann->multiplier) / -2.0) *
+						 (float) ann->multiplier);
+	}
+}
+#endif
+
+
+/* INTERNAL FUNCTION
+   Allocates the main structure and sets some default values.
+ */
+struct fann *fann_allocate_structure(unsigned int num_layers)
+{
+	struct fann *ann;
+
+	if(num_layers < 2)
+	{
+#ifdef DEBUG
+		printf("less than 2 layers - ABORTING.\n");
+#endif
+		return NULL;
+	}
+
+	/* allocate and initialize the main network structure */
+	ann = (struct fann *) malloc(sizeof(struct fann));
+	if(ann == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		return NULL;
+	}
+
+	ann->errno_f = FANN_E_NO_ERROR;
+	ann->error_log = fann_default_error_log;
+	ann->errstr = NULL;
+	ann->learning_rate = 0.7f;
+	ann->learning_momentum = 0.0;
+	ann->total_neurons = 0;
+	ann->total_connections = 0;
+	ann->num_input = 0;
+	ann->num_output = 0;
+	ann->values = NULL;
+	ann->sums = NULL;
+	ann->train_errors = NULL;
+	ann->train_slopes = NULL;
+	ann->prev_steps = NULL;
+	ann->prev_train_slopes = NULL;
+	ann->prev_weights_deltas = NULL;
+	ann->precision = FANN_PRECISION_DEFAULT;
+	ann->activation_approximation = FANN_APPROXIMATION_NONE;
+	ann->weights_float = NULL;
+	ann->values_float = NULL;
+	ann->weights_half = NULL;
+	ann->weights_int8 = NULL;
+	ann->weights_int8_scale = NULL;
+	ann->values_int8 = NULL;
+	ann->values_int8_scale = NULL;
+	ann->precision_stale = 0;
+	ann->num_threads = 0;
+	ann->parallel_workers = NULL;
+	ann->num_parallel_workers = 0;
+	ann->batch_size = 32;
+	ann->batch_values = NULL;
+	ann->batch_sums = NULL;
+	ann->batch_errors = NULL;
+	ann->batch_buffer_size = 0;
+	ann->connection_mask = NULL;
+	ann->total_active_connections = 0;
+	ann->active_offsets = NULL;
+	ann->active_first = NULL;
+	ann->training_algorithm = FANN_TRAIN_RPROP;
+	ann->num_MSE = 0;
+	ann->MSE_value = 0;
+	ann->num_bit_fail = 0;
+	ann->bit_fail_limit = (fann_type)0.35;
+	ann->network_type = FANN_NETTYPE_LAYER;
+	ann->train_error_function = FANN_ERRORFUNC_TANH;
+	ann->train_stop_function = FANN_STOPFUNC_MSE;
+	ann->callback = NULL;
+    ann->user_data = NULL; /* User is responsible for deallocation */
+	ann->weights = NULL;
+	ann->weights_mapping = NULL;
+	ann->weights_mapping_size = 0;
+	ann->connections = NULL;
+	ann->output = NULL;
+#ifndef FIXEDFANN
+	ann->scale_mean_in = NULL;
+	ann->scale_deviation_in = NULL;
+	ann->scale_new_min_in = NULL;
+	ann->scale_factor_in = NULL;
+	ann->scale_mean_out = NULL;
+	ann->scale_deviation_out = NULL;
+	ann->scale_new_min_out = NULL;
+	ann->scale_factor_out = NULL;
+#endif
+
+	/* variables used for cascade correlation (reasonable defaults) */
+	ann->cascade_output_change_fraction = 0.01f;
+	ann->cascade_candidate_change_fraction = 0.01f;
+	ann->cascade_output_stagnation_epochs = 12;
+	ann->cascade_candidate_stagnation_epochs = 12;
+	ann->cascade_num_candidate_groups = 2;
+	ann->cascade_weight_multiplier = (fann_type)0.4;
+	ann->cascade_candidate_limit = (fann_type)1000.0;
+	ann->cascade_max_out_epochs = 150;
+	ann->cascade_max_cand_epochs = 150;
+	ann->cascade_min_out_epochs = 50;
+	ann->cascade_min_cand_epochs = 50;
+	ann->cascade_candidate_scores = NULL;
+	ann->cascade_activation_functions_count = 10;
+	ann->cascade_activation_functions =
+		(enum fann_activationfunc_enum *)calloc(ann->cascade_activation_functions_count,
+							   sizeof(enum fann_activationfunc_enum));
+	if(ann->cascade_activation_functions == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		free(ann);
+		return NULL;
+	}
+
+	ann->cascade_activation_functions[0] = FANN_SIGMOID;
+	ann->cascade_activation_functions[1] = FANN_SIGMOID_SYMMETRIC;
+	ann->cascade_activation_functions[2] = FANN_GAUSSIAN;
+	ann->cascade_activation_functions[3] = FANN_GAUSSIAN_SYMMETRIC;
+	ann->cascade_activation_functions[4] = FANN_ELLIOT;
+	ann->cascade_activation_functions[5] = FANN_ELLIOT_SYMMETRIC;
+	ann->cascade_activation_functions[6] = FANN_SIN_SYMMETRIC;
+	ann->cascade_activation_functions[7] = FANN_COS_SYMMETRIC;
+	ann->cascade_activation_functions[8] = FANN_SIN;
+	ann->cascade_activation_functions[9] = FANN_COS;
+
+	ann->cascade_activation_steepnesses_count = 4;
+	ann->cascade_activation_steepnesses =
+		(fann_type *)calloc(ann->cascade_activation_steepnesses_count,
+							   sizeof(fann_type));
+	if(ann->cascade_activation_steepnesses == NULL)
+	{
+		fann_safe_free(ann->cascade_activation_functions);
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		free(ann);
+		return NULL;
+	}
+
+	ann->cascade_activation_steepnesses[0] = (fann_type)0.25;
+	ann->cascade_activation_steepnesses[1] = (fann_type)0.5;
+	ann->cascade_activation_steepnesses[2] = (fann_type)0.75;
+	ann->cascade_activation_steepnesses[3] = (fann_type)1.0;
+
+	/* Variables for use with with Quickprop training (reasonable defaults) */
+	ann->quickprop_decay = -0.0001f;
+	ann->quickprop_mu = 1.75;
+
+	/* Variables for use with with RPROP training (reasonable defaults) */
+	ann->rprop_increase_factor = 1.2f;
+	ann->rprop_decrease_factor = 0.5;
+	ann->rprop_delta_min = 0.0;
+	ann->rprop_delta_max = 50.0;
+	ann->rprop_delta_zero = 0.1f;
+
+ 	/* Variables for use with SARPROP training (reasonable defaults) */
+ 	ann->sarprop_weight_decay_shift = -6.644f;
+ 	ann->sarprop_step_error_threshold_factor = 0.1f;
+ 	ann->sarprop_step_error_shift = 1.385f;
+ 	ann->sarprop_temperature = 0.015f;
+ 	ann->sarprop_epoch = 0;
+
+	/* Variables for use with Adam training (reasonable defaults) */
+	ann->adam_beta1 = 0.9f;
+	ann->adam_beta2 = 0.999f;
+	ann->adam_epsilon = 1e-8f;
+	ann->adam_weight_decay = 0.0f;
+	ann->adam_timestep = 0;
+
+	fann_init_error_data((struct fann_error *) ann);
+
+#ifdef FIXEDFANN
+	/* these values are only boring defaults, and should really
+	 * never be used, since the real values are always loaded from a file. */
+	ann->decimal_point = 8;
+	ann->multiplier = 256;
+#endif
+
+	/* allocate room for the layers */
+	ann->first_layer = (struct fann_layer *) calloc(num_layers, sizeof(struct fann_layer));
+	if(ann->first_layer == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		free(ann);
+		return NULL;
+	}
+
+	ann->last_layer = ann->first_layer + num_layers;
+
+	return ann;
+}
+
+/* INTERNAL FUNCTION
+   Allocates room for the scaling parameters.
+ */
+int fann_allocate_scale(struct fann *ann)
+{
+	/* todo this should only be allocated when needed */
+#ifndef FIXEDFANN
+	unsigned int i = 0;
+#define SCALE_ALLOCATE( what, where, default_value )		    			\
+		ann->what##_##where = (float *)calloc(								\
+			ann->num_##where##put,											\
+			sizeof( float )													\
+			);																\
+		if( ann->what##_##where == NULL )									\
+		{																	\
+			fann_error( NULL, FANN_E_CANT_ALLOCATE_MEM );					\
+			fann_destroy( ann );                            				\
+			return 1;														\
+		}																	\
+		for( i = 0; i < ann->num_##where##put; i++ )						\
+			ann->what##_##where[ i ] = ( default_value );
+
+	SCALE_ALLOCATE( scale_mean,		in,		0.0 )
+	SCALE_ALLOCATE( scale_deviation,	in,		1.0 )
+	SCALE_ALLOCATE( scale_new_min,	in,		-1.0 )
+	SCALE_ALLOCATE( scale_factor,		in,		1.0 )
+
+	SCALE_ALLOCATE( scale_mean,		out,	0.0 )
+	SCALE_ALLOCATE( scale_deviation,	out,	1.0 )
+	SCALE_ALLOCATE( scale_new_min,	out,	-1.0 )
+	SCALE_ALLOCATE( scale_factor,		out,	1.0 )
+#undef SCALE_ALLOCATE
+#endif
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Allocates room for the neurons.
+ */
+void fann_allocate_neurons(struct fann *ann)
+{
+	struct fann_layer *layer_it;
+	struct fann_neuron *neurons;
+	unsigned int num_neurons_so_far = 0;
+	unsigned int num_neurons = 0;
 
-    if (orig->prev_steps)
-    {
-        copy->prev_steps = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
-        if (copy->prev_steps == NULL)
-        {
-            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
-            fann_destroy(copy);
-            return NULL;
-        }
-        memcpy(copy->prev_steps, orig->prev_steps, copy->total_connections_allocated * sizeof(fann_type));
-    }
+	/* all the neurons is allocated in one long array (calloc clears mem) */
+	neurons = (struct fann_neuron *) calloc(ann->total_neurons, sizeof(struct fann_neuron));
+	ann->total_neurons_allocated = ann->total_neurons;
 
-    if (orig->prev_train_slopes)
-    {
-        copy->prev_train_slopes = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
-        if (copy->prev_train_slopes == NULL)
-        {
-            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
-            fann_destroy(copy);
-            return NULL;
-        }
-        memcpy(copy->prev_train_slopes,orig->prev_train_slopes, copy->total_connections_allocated * sizeof(fann_type));
-    }
+	if(neurons == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
 
-    if (orig->prev_weights_deltas)
-    {
-        copy->prev_weights_deltas = (fann_type *) malloc(copy->total_connections_allocated * sizeof(fann_type));
-        if(copy->prev_weights_deltas == NULL)
-        {
-            fann_error((struct fann_error *) orig, FANN_E_CANT_ALLOCATE_MEM);
-            fann_destroy(copy);
-            return NULL;
-        }
-        memcpy(copy->prev_weights_deltas, orig->prev_weights_deltas,copy->total_connections_allocated * sizeof(fann_type));
+	for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++)
+	{
+		num_neurons = (unsigned int)(layer_it->last_neuron - layer_it->first_neuron);
+		layer_it->first_neuron = neurons + num_neurons_so_far;
+		layer_it->last_neuron = layer_it->first_neuron + num_neurons;
+		num_neurons_so_far += num_neurons;
+	}
+
+	ann->values = (fann_type *) calloc(ann->total_neurons, sizeof(fann_type));
+	ann->sums = (fann_type *) calloc(ann->total_neurons, sizeof(fann_type));
+	if(ann->values == NULL || ann->sums == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
+
+	ann->output = (fann_type *) calloc(num_neurons, sizeof(fann_type));
+	if(ann->output == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
+}
+
+/* INTERNAL FUNCTION
+   Allocate room for the connections.
+ */
+void fann_allocate_connections(struct fann *ann)
+{
+	ann->weights = (fann_type *) calloc(ann->total_connections, sizeof(fann_type));
+	if(ann->weights == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
+	ann->total_connections_allocated = ann->total_connections;
+
+	/* TODO make special cases for all places where the connections
+	 * is used, so that it is not needed for fully connected networks.
+	 */
+	ann->connections =
+		(struct fann_neuron **) calloc(ann->total_connections_allocated,
+									   sizeof(struct fann_neuron *));
+	if(ann->connections == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return;
+	}
+}
+
+#ifdef FANN_NO_SEED
+int FANN_SEED_RAND = 0;
+#else
+int FANN_SEED_RAND = 1;
+#endif
+
+FANN_EXTERNAL void FANN_API fann_disable_seed_rand()
+{
+    FANN_SEED_RAND = 0;
+}
+
+FANN_EXTERNAL void FANN_API fann_enable_seed_rand()
+{
+    FANN_SEED_RAND = 1;
+}
+
+/* INTERNAL FUNCTION
+   Seed the random function.
+ */
+void fann_seed_rand(void) {
+#ifndef _WIN32
+	FILE *fp = fopen("/dev/urandom", "r");
+	unsigned int foo;
+	struct timeval t;
+
+	if(!fp)
+	{
+		gettimeofday(&t, NULL);
+		foo = t.tv_usec;
+#ifdef DEBUG
+		printf("unable to open /dev/urandom\n");
+#endif
+	}
+	else
+	{
+	        if(fread(&foo, sizeof(foo), 1, fp) != 1)
+	        {
+  		       gettimeofday(&t, NULL);
+		       foo = t.tv_usec;
+#ifdef DEBUG
+		       printf("unable to read from /dev/urandom\n");
+#endif
+		}
+		fclose(fp);
+	}
+    if(FANN_SEED_RAND) {
+        srand(foo);
+    }
+#else
+	/* COMPAT_TIME REPLACEMENT */
+    if(FANN_SEED_RAND) {
+    	srand(GetTickCount());
     }
+#endif
+}
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define FANN_BINARY_MAGIC "FANN_BIN"
+#define FANN_BINARY_VERSION 2
+#define FANN_BINARY_HEADER_SIZE 64
+#define FANN_BINARY_ALIGNMENT 64
+#define FANN_BUNDLE_MAGIC "FANN_BDL"
+#define FANN_BUNDLE_VERSION 1
+
+/* Create a network from a configuration file.
+ */
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_file(const char *configuration_file)
+{
+	struct fann *ann;
+	FILE *conf = fopen(configuration_file, "r");
+
+	if(!conf)
+	{
+		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
+		return NULL;
+	}
+	ann = fann_create_from_fd(conf, configuration_file, 1);
+	fclose(conf);
+	return ann;
+}
+
+/* Save the network.
+ */
+FANN_EXTERNAL int FANN_API fann_save(struct fann *ann, const char *configuration_file)
+{
+	return fann_save_internal(ann, configuration_file, 0);
+}
+
+/* Save the network as fixed point data.
+ */
+FANN_EXTERNAL int FANN_API fann_save_to_fixed(struct fann *ann, const char *configuration_file)
+{
+	return fann_save_internal(ann, configuration_file, 1);
+}
+
+/* INTERNAL FUNCTION
+   Frees the weights, or unmaps them when they point into a file mapped by
+   fann_create_from_binary.
+ */
+void fann_free_weights(struct fann *ann)
+{
+#ifndef _WIN32
+	if(ann->weights_mapping != NULL)
+	{
+		munmap(ann->weights_mapping, ann->weights_mapping_size);
+		ann->weights_mapping = NULL;
+		ann->weights_mapping_size = 0;
+		ann->weights = NULL;
+		return;
+	}
+#endif
+	fann_safe_free(ann->weights);
+}
+
+/* INTERNAL FUNCTION
+   Moves weights that point into a mapped file to allocated memory, before they are
+   reallocated. Returns -1 if the memory could not be allocated.
+ */
+int fann_unmap_weights(struct fann *ann)
+{
+	fann_type *weights;
+
+	if(ann->weights_mapping == NULL)
+		return 0;
+
+	weights = (fann_type *) malloc(ann->total_connections_allocated * sizeof(fann_type));
+	if(weights == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	memcpy(weights, ann->weights, ann->total_connections_allocated * sizeof(fann_type));
+	fann_free_weights(ann);
+	ann->weights = weights;
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Returns 1 when numbers are stored little-endian, as the binary files are.
+ */
+int fann_is_little_endian(void)
+{
+	const uint16_t one = 1;
+
+	return *(const unsigned char *) &one == 1;
+}
+
+/* INTERNAL FUNCTION
+   Reverses the bytes of each of the count elements of array.
+ */
+void fann_swap_bytes(void *array, size_t element_size, size_t count)
+{
+	unsigned char *element = (unsigned char *) array;
+	unsigned char swapped;
+	size_t i, j;
+
+	for(i = 0; i != count; i++, element += element_size)
+	{
+		for(j = 0; j != element_size / 2; j++)
+		{
+			swapped = element[j];
+			element[j] = element[element_size - 1 - j];
+			element[element_size - 1 - j] = swapped;
+		}
+	}
+}
+
+/* INTERNAL FUNCTION
+   Writes the size lowest bytes of value to buffer, little-endian.
+ */
+void fann_write_le(unsigned char *buffer, uint64_t value, unsigned int size)
+{
+	unsigned int i;
+
+	for(i = 0; i != size; i++)
+	{
+		buffer[i] = (unsigned char) (value >> (8 * i));
+	}
+}
+
+/* INTERNAL FUNCTION
+   Reads a size bytes little-endian number from buffer.
+ */
+uint64_t fann_read_le(const unsigned char *buffer, unsigned int size)
+{
+	uint64_t value = 0;
+	unsigned int i;
+
+	for(i = size; i != 0; i--)
+	{
+		value = (value << 8) | buffer[i - 1];
+	}
+	return value;
+}
+
+/* INTERNAL FUNCTION
+   Writes count elements of element_size bytes to file, little-endian whatever the byte
+   order of the machine. Returns -1 on failure.
+ */
+int fann_write_le_array(FILE *file, const void *array, size_t element_size, size_t count)
+{
+	unsigned char buffer[4096];
+	size_t chunk = sizeof(buffer) / element_size;
+	size_t done, num;
+
+	if(fann_is_little_endian())
+		return fwrite(array, element_size, count, file) == count ? 0 : -1;
+
+	for(done = 0; done < count; done += num)
+	{
+		num = count - done < chunk ? count - done : chunk;
+		memcpy(buffer, (const unsigned char *) array + done * element_size, num * element_size);
+		fann_swap_bytes(buffer, element_size, num);
+		if(fwrite(buffer, element_size, num, file) != num)
+			return -1;
+	}
+	return 0;
+}
+
+/* INTERNAL FUNCTION
+   Writes zeros up to the next multiple of FANN_BINARY_ALIGNMENT and stores the offset
+   reached in offset. Returns -1 on failure.
+ */
+int fann_write_binary_padding(FILE *file, long *offset)
+{
+	long position = ftell(file);
 
-    return copy;
+	if(position < 0)
+		return -1;
+	for(; position % FANN_BINARY_ALIGNMENT != 0; position++)
+	{
+		if(fputc(0, file) == EOF)
+			return -1;
+	}
+	*offset = position;
+	return 0;
 }
 
-FANN_EXTERNAL void FANN_API fann_print_connections(struct fann *ann)
+/* INTERNAL FUNCTION
+   Writes value in as few bytes as it needs, 7 bits per byte from the lowest ones, with the
+   high bit set on every byte but the last. Returns -1 on failure.
+ */
+int fann_write_varint(FILE *file, unsigned int value)
 {
-	struct fann_layer *layer_it;
-	struct fann_neuron *neuron_it;
-	unsigned int i;
-	int value;
-	char *neurons;
-	unsigned int num_neurons = fann_get_total_neurons(ann) - fann_get_num_output(ann);
+	while(value >= 0x80)
+	{
+		if(fputc((int) ((value & 0x7F) | 0x80), file) == EOF)
+			return -1;
+		value >>= 7;
+	}
+	return fputc((int) value, file) == EOF ? -1 : 0;
+}
 
-	neurons = (char *) malloc(num_neurons + 1);
-	if(neurons == NULL)
+/* INTERNAL FUNCTION
+   Reads a value written by fann_write_varint at *position and moves *position past it.
+   Returns -1 when the value goes past end or does not fit in an unsigned int.
+ */
+int fann_read_varint(const unsigned char **position, const unsigned char *end, unsigned int *value)
+{
+	unsigned int shift;
+	unsigned char byte;
+
+	*value = 0;
+	for(shift = 0; *position != end && shift < 32; shift += 7)
 	{
-		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
-		return;
+		byte = *(*position)++;
+		if(shift == 28 && (byte & 0x70) != 0)
+			return -1;
+		*value |= (unsigned int) (byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return 0;
 	}
-	neurons[num_neurons] = 0;
+	return -1;
+}
 
-	printf("Layer / Neuron ");
-	for(i = 0; i < num_neurons; i++)
+/* INTERNAL FUNCTION
+   Opens configuration_file with ".tmp" appended in mode, to be written and then moved over
+   configuration_file by fann_replace_file, so that the file is never left half written.
+   *temporary_file is the allocated name, which fann_replace_file frees.
+   Returns NULL on failure.
+ */
+FILE *fann_open_temporary_file(struct fann_error *errdat, const char *configuration_file, const char *mode,
+							   char **temporary_file)
+{
+	FILE *file;
+
+	*temporary_file = (char *) malloc(strlen(configuration_file) + 5);
+	if(*temporary_file == NULL)
 	{
-		printf("%d", i % 10);
+		fann_error(errdat, FANN_E_CANT_ALLOCATE_MEM);
+		return NULL;
 	}
-	printf("\n");
+	sprintf(*temporary_file, "%s.tmp", configuration_file);
 
-	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+	file = fopen(*temporary_file, mode);
+	if(!file)
 	{
-		for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++)
-		{
+		fann_error(errdat, FANN_E_CANT_OPEN_CONFIG_W, *temporary_file);
+		free(*temporary_file);
+		*temporary_file = NULL;
+	}
+	return file;
+}
 
-			memset(neurons, (int) '.', num_neurons);
-			for(i = neuron_it->first_con; i < neuron_it->last_con; i++)
-			{
-				if(ann->weights[i] < 0)
-				{
-#ifdef FIXEDFANN
-					value = (int) ((ann->weights[i] / (double) ann->multiplier) - 0.5);
-#else
-					value = (int) ((ann->weights[i]) - 0.5);
-#endif
-					if(value < -25)
-						value = -25;
-					neurons[ann->connections[i] - ann->first_layer->first_neuron] = (char)('a' - value);
-				}
-				else
-				{
-#ifdef FIXEDFANN
-					value = (int) ((ann->weights[i] / (double) ann->multiplier) + 0.5);
-#else
-					value = (int) ((ann->weights[i]) + 0.5);
+/* INTERNAL FUNCTION
+   Closes file, opened by fann_open_temporary_file, and renames it over configuration_file
+   when retval, the result of writing it, is 0. Otherwise, or when that fails, the temporary
+   file is removed and configuration_file is left as it was. Frees temporary_file.
+   Returns 0 on success and -1 on failure.
+ */
+int fann_replace_file(struct fann_error *errdat, FILE *file, char *temporary_file,
+					  const char *configuration_file, int retval)
+{
+	if(fclose(file) != 0)
+		retval = -1;
+
+#ifdef _WIN32
+	/* rename does not replace an existing file on Windows */
+	if(retval == 0)
+		remove(configuration_file);
 #endif
-					if(value > 25)
-						value = 25;
-					neurons[ann->connections[i] - ann->first_layer->first_neuron] = (char)('A' + value);
-				}
-			}
-			printf("L %3d / N %4d %s\n", (int)(layer_it - ann->first_layer),
-				   (int)(neuron_it - ann->first_layer->first_neuron), neurons);
-		}
+	if(retval == 0 && rename(temporary_file, configuration_file) != 0)
+		retval = -1;
+	if(retval != 0)
+	{
+		fann_error(errdat, FANN_E_CANT_OPEN_CONFIG_W, configuration_file);
+		remove(temporary_file);
 	}
 
-	free(neurons);
+	free(temporary_file);
+	return retval;
 }
 
-/* Initialize the weights using Widrow + Nguyen's algorithm.
-*/
-FANN_EXTERNAL void FANN_API fann_init_weights(struct fann *ann, struct fann_train_data *train_data)
-{
-	fann_type smallest_inp, largest_inp;
-	unsigned int dat = 0, elem, num_connect, num_hidden_neurons;
-	struct fann_layer *layer_it;
-	struct fann_neuron *neuron_it, *last_neuron, *bias_neuron;
+#ifndef FIXEDFANN
 
-#ifdef FIXEDFANN
-	unsigned int multiplier = ann->multiplier;
-#endif
-	float scale_factor;
+/* INTERNAL FUNCTION
+   Writes the connections of a pruned network in the sparse encoding of fann_save_binary:
+   the sources of each neuron as runs of consecutive neurons, then the gap before each kept
+   connection. Returns -1 on failure.
+ */
+int fann_write_sparse_connections(struct fann *ann, FILE *file)
+{
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	struct fann_neuron *last_neuron = (ann->last_layer - 1)->last_neuron;
+	struct fann_neuron *neuron_it;
+	unsigned int i, run_start, num_runs, next = 0;
 
-	for(smallest_inp = largest_inp = train_data->input[0][0]; dat < train_data->num_data; dat++)
+	for(neuron_it = first_neuron; neuron_it != last_neuron; neuron_it++)
 	{
-		for(elem = 0; elem < train_data->num_input; elem++)
+		num_runs = 0;
+		for(i = neuron_it->first_con; i != neuron_it->last_con; i++)
 		{
-			if(train_data->input[dat][elem] < smallest_inp)
-				smallest_inp = train_data->input[dat][elem];
-			if(train_data->input[dat][elem] > largest_inp)
-				largest_inp = train_data->input[dat][elem];
+			if(i == neuron_it->first_con || ann->connections[i] != ann->connections[i - 1] + 1)
+				num_runs++;
+		}
+		if(fann_write_varint(file, num_runs) != 0)
+			return -1;
+		for(run_start = neuron_it->first_con; run_start != neuron_it->last_con; run_start = i)
+		{
+			for(i = run_start + 1; i != neuron_it->last_con && ann->connections[i] == ann->connections[i - 1] + 1; i++);
+			if(fann_write_varint(file, (unsigned int) (ann->connections[run_start] - first_neuron)) != 0 ||
+			   fann_write_varint(file, i - run_start) != 0)
+				return -1;
 		}
 	}
 
-	num_hidden_neurons = (unsigned int)(
-		ann->total_neurons - (ann->num_input + ann->num_output +
-							  (ann->last_layer - ann->first_layer)));
-	scale_factor =
-		(float) (pow
-				 ((double) (0.7f * (double) num_hidden_neurons),
-				  (double) (1.0f / (double) ann->num_input)) / (double) (largest_inp -
-																		 smallest_inp));
-
-#ifdef DEBUG
-	printf("Initializing weights with scale factor %f\n", scale_factor);
-#endif
-	bias_neuron = ann->first_layer->last_neuron - 1;
-	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer; layer_it++)
+	for(i = 0; i != ann->total_connections; i++)
 	{
-		last_neuron = layer_it->last_neuron;
-
-		if(ann->network_type == FANN_NETTYPE_LAYER)
+		if(ann->connection_mask[i] != 0)
 		{
-			bias_neuron = (layer_it - 1)->last_neuron - 1;
+			if(fann_write_varint(file, i - next) != 0)
+				return -1;
+			next = i + 1;
 		}
+	}
+	return 0;
+}
 
-		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+/* INTERNAL FUNCTION
+   Decodes the connections written by fann_write_sparse_connections from size bytes of
+   buffer, and builds the connection mask and the lists of kept connections from them.
+   Returns -1 when the encoding does not match the network.
+ */
+int fann_read_sparse_connections(struct fann *ann, const unsigned char *buffer, size_t size,
+								 unsigned int num_kept)
+{
+	const unsigned char *position = buffer;
+	const unsigned char *end = buffer + size;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	struct fann_neuron *last_neuron = (ann->last_layer - 1)->last_neuron;
+	struct fann_neuron *neuron_it;
+	unsigned int i, j, num_runs, source, length, gap, next = 0;
+
+	for(neuron_it = first_neuron; neuron_it != last_neuron; neuron_it++)
+	{
+		if(fann_read_varint(&position, end, &num_runs) != 0)
+			return -1;
+		for(i = neuron_it->first_con; num_runs > 0; num_runs--)
 		{
-			for(num_connect = neuron_it->first_con; num_connect < neuron_it->last_con;
-				num_connect++)
+			if(fann_read_varint(&position, end, &source) != 0 || fann_read_varint(&position, end, &length) != 0 ||
+			   length > neuron_it->last_con - i || source > ann->total_neurons || length > ann->total_neurons - source)
+				return -1;
+			for(j = 0; j != length; j++)
 			{
-				if(bias_neuron == ann->connections[num_connect])
-				{
-#ifdef FIXEDFANN
-					ann->weights[num_connect] =
-						(fann_type) fann_rand(-scale_factor, scale_factor * multiplier);
-#else
-					ann->weights[num_connect] = (fann_type) fann_rand(-scale_factor, scale_factor);
-#endif
-				}
-				else
-				{
-#ifdef FIXEDFANN
-					ann->weights[num_connect] = (fann_type) fann_rand(0, scale_factor * multiplier);
-#else
-					ann->weights[num_connect] = (fann_type) fann_rand(0, scale_factor);
-#endif
-				}
+				ann->connections[i++] = first_neuron + source + j;
 			}
 		}
+		if(i != neuron_it->last_con)
+			return -1;
 	}
 
-#ifndef FIXEDFANN
-	if(ann->prev_train_slopes != NULL)
+	if(ann->connection_mask == NULL && fann_allocate_connection_mask(ann) == -1)
+		return -1;
+	memset(ann->connection_mask, 0, ann->total_connections_allocated * sizeof(fann_type));
+	for(i = 0; i != num_kept; i++)
 	{
-		fann_clear_train_arrays(ann);
+		if(fann_read_varint(&position, end, &gap) != 0 || gap >= ann->total_connections - next)
+			return -1;
+		next += gap;
+		ann->connection_mask[next++] = 1;
 	}
-#endif
+	return fann_update_active_connections(ann);
 }
 
-FANN_EXTERNAL void FANN_API fann_print_parameters(struct fann *ann)
+/* INTERNAL FUNCTION
+   Writes the weights of count connections, or only those kept by mask when it is not NULL,
+   with the precision of fann_save_binary_with_precision. Returns -1 on failure.
+ */
+int fann_write_binary_weights(FILE *file, const fann_type *weights, const fann_type *mask,
+							  unsigned int count, enum fann_precision_enum precision)
 {
-	struct fann_layer *layer_it;
-#ifndef FIXEDFANN
-	unsigned int i;
-#endif
+	fann_type values[512];
+	float floats[512];
+	uint16_t halves[512];
+	unsigned int i, num = 0;
+	int retval = 0;
 
-	printf("Input layer                          :%4d neurons, 1 bias\n", ann->num_input);
-	for(layer_it = ann->first_layer + 1; layer_it != ann->last_layer - 1; layer_it++)
+	for(i = 0; retval == 0 && i != count; i++)
 	{
-		if(ann->network_type == FANN_NETTYPE_SHORTCUT)
+		if(mask == NULL || mask[i] != 0)
 		{
-			printf("  Hidden layer                       :%4d neurons, 0 bias\n",
-				   (int)(layer_it->last_neuron - layer_it->first_neuron));
+			if(precision == FANN_PRECISION_FLOAT)
+				floats[num] = (float) weights[i];
+			else if(precision == FANN_PRECISION_HALF)
+				halves[num] = fann_float_to_half((float) weights[i]);
+			else if(precision == FANN_PRECISION_BFLOAT16)
+				halves[num] = fann_float_to_bfloat16((float) weights[i]);
+			else
+				values[num] = weights[i];
+			num++;
 		}
-		else
+		if(num == 512 || (i + 1 == count && num > 0))
 		{
-			printf("  Hidden layer                       :%4d neurons, 1 bias\n",
-				   (int)(layer_it->last_neuron - layer_it->first_neuron - 1));
+			if(precision == FANN_PRECISION_FLOAT)
+				retval = fann_write_le_array(file, floats, sizeof(float), num);
+			else if(precision == FANN_PRECISION_HALF || precision == FANN_PRECISION_BFLOAT16)
+				retval = fann_write_le_array(file, halves, sizeof(uint16_t), num);
+			else
+				retval = fann_write_le_array(file, values, sizeof(fann_type), num);
+			num = 0;
 		}
 	}
-	printf("Output layer                         :%4d neurons\n", ann->num_output);
-	printf("Total neurons and biases             :%4d\n", fann_get_total_neurons(ann));
-	printf("Total connections                    :%4d\n", ann->total_connections);
-	printf("Connection rate                      :%8.3f\n", ann->connection_rate);
-	printf("Network type                         :   %s\n", FANN_NETTYPE_NAMES[ann->network_type]);
-#ifdef FIXEDFANN
-	printf("Decimal point                        :%4d\n", ann->decimal_point);
-	printf("Multiplier                           :%4d\n", ann->multiplier);
-#else
-	printf("Training algorithm                   :   %s\n", FANN_TRAIN_NAMES[ann->training_algorithm]);
-	printf("Training error function              :   %s\n", FANN_ERRORFUNC_NAMES[ann->train_error_function]);
-	printf("Training stop function               :   %s\n", FANN_STOPFUNC_NAMES[ann->train_stop_function]);
-#endif
-#ifdef FIXEDFANN
-	printf("Bit fail limit                       :%4d\n", ann->bit_fail_limit);
-#else
-	printf("Bit fail limit                       :%8.3f\n", ann->bit_fail_limit);
-	printf("Learning rate                        :%8.3f\n", ann->learning_rate);
-	printf("Learning momentum                    :%8.3f\n", ann->learning_momentum);
-	printf("Quickprop decay                      :%11.6f\n", ann->quickprop_decay);
-	printf("Quickprop mu                         :%8.3f\n", ann->quickprop_mu);
-	printf("RPROP increase factor                :%8.3f\n", ann->rprop_increase_factor);
-	printf("RPROP decrease factor                :%8.3f\n", ann->rprop_decrease_factor);
-	printf("RPROP delta min                      :%8.3f\n", ann->rprop_delta_min);
-	printf("RPROP delta max                      :%8.3f\n", ann->rprop_delta_max);
-	printf("Cascade output change fraction       :%11.6f\n", ann->cascade_output_change_fraction);
-	printf("Cascade candidate change fraction    :%11.6f\n", ann->cascade_candidate_change_fraction);
-	printf("Cascade output stagnation epochs     :%4d\n", ann->cascade_output_stagnation_epochs);
-	printf("Cascade candidate stagnation epochs  :%4d\n", ann->cascade_candidate_stagnation_epochs);
-	printf("Cascade max output epochs            :%4d\n", ann->cascade_max_out_epochs);
-	printf("Cascade min output epochs            :%4d\n", ann->cascade_min_out_epochs);
-	printf("Cascade max candidate epochs         :%4d\n", ann->cascade_max_cand_epochs);
-	printf("Cascade min candidate epochs         :%4d\n", ann->cascade_min_cand_epochs);
-	printf("Cascade weight multiplier            :%8.3f\n", ann->cascade_weight_multiplier);
-	printf("Cascade candidate limit              :%8.3f\n", ann->cascade_candidate_limit);
-	for(i = 0; i < ann->cascade_activation_functions_count; i++)
-		printf("Cascade activation functions[%d]      :   %s\n", i,
-			FANN_ACTIVATIONFUNC_NAMES[ann->cascade_activation_functions[i]]);
-	for(i = 0; i < ann->cascade_activation_steepnesses_count; i++)
-		printf("Cascade activation steepnesses[%d]    :%8.3f\n", i,
-			ann->cascade_activation_steepnesses[i]);
-
-	printf("Cascade candidate groups             :%4d\n", ann->cascade_num_candidate_groups);
-	printf("Cascade no. of candidates            :%4d\n", fann_get_cascade_num_candidates(ann));
-
-	/* TODO: dump scale parameters */
-#endif
-}
-
-FANN_GET(unsigned int, num_input)
-FANN_GET(unsigned int, num_output)
-
-FANN_EXTERNAL unsigned int FANN_API fann_get_total_neurons(struct fann *ann)
-{
-	if(ann->network_type)
-	{
-		return ann->total_neurons;
-	}
-	else
-	{
-		/* -1, because there is always an unused bias neuron in the last layer */
-		return ann->total_neurons - 1;
-	}
-}
-
-FANN_GET(unsigned int, total_connections)
-
-FANN_EXTERNAL enum fann_nettype_enum FANN_API fann_get_network_type(struct fann *ann)
-{
-    /* Currently two types: LAYER = 0, SHORTCUT = 1 */
-    /* Enum network_types must be set to match the return values  */
-    return ann->network_type;
+	return retval;
 }
 
-FANN_EXTERNAL float FANN_API fann_get_connection_rate(struct fann *ann)
+/* INTERNAL FUNCTION
+   Reads count weights of weight_size bytes, converting them to fann_type when they have
+   another size. Weights of 2 bytes are bfloat16 when bfloat16 is set, and half precision
+   otherwise. Returns the number of weights read.
+ */
+unsigned int fann_read_binary_weights(FILE *file, fann_type *weights, unsigned int count,
+									  unsigned int weight_size, unsigned int bfloat16)
 {
-    return ann->connection_rate;
+	double buffer[512];
+	float converted[512];
+	uint16_t *halves = (uint16_t *) buffer;
+	unsigned int i, j, num, chunk;
+
+	if(weight_size == sizeof(fann_type))
+	{
+		i = (unsigned int) fread(weights, sizeof(fann_type), count, file);
+		if(!fann_is_little_endian())
+			fann_swap_bytes(weights, sizeof(fann_type), i);
+		return i;
+	}
+
+	chunk = sizeof(converted) / sizeof(float);
+	for(i = 0; i < count; i += num)
+	{
+		num = count - i < chunk ? count - i : chunk;
+		if(fread(buffer, weight_size, num, file) != num)
+			break;
+		if(!fann_is_little_endian())
+			fann_swap_bytes(buffer, weight_size, num);
+		if(weight_size == sizeof(uint16_t) && !bfloat16)
+			fann_half_to_float_array(halves, converted, num);
+		for(j = 0; j != num; j++)
+		{
+			if(weight_size == sizeof(uint16_t))
+				weights[i + j] = (fann_type) (bfloat16 ? fann_bfloat16_to_float(halves[j]) : converted[j]);
+			else if(weight_size == sizeof(float))
+				weights[i + j] = (fann_type) ((float *) buffer)[j];
+			else
+				weights[i + j] = (fann_type) buffer[j];
+		}
+	}
+	return i < count ? i : count;
 }
 
-FANN_EXTERNAL unsigned int FANN_API fann_get_num_layers(struct fann *ann)
+FANN_EXTERNAL int FANN_API fann_save_binary(struct fann *ann, const char *configuration_file)
 {
-    return (unsigned int)(ann->last_layer - ann->first_layer);
+	return fann_save_binary_with_precision(ann, configuration_file, FANN_PRECISION_DEFAULT);
 }
 
-FANN_EXTERNAL void FANN_API fann_get_layer_array(struct fann *ann, unsigned int *layers)
+FANN_EXTERNAL int FANN_API fann_save_binary_with_precision(struct fann *ann, const char *configuration_file,
+														   enum fann_precision_enum precision)
 {
-    struct fann_layer *layer_it;
+	char *temporary_file;
+	int retval;
+	FILE *file;
 
-    for (layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++) {
-        unsigned int count = (unsigned int)(layer_it->last_neuron - layer_it->first_neuron);
-        /* Remove the bias from the count of neurons. */
-        switch (fann_get_network_type(ann)) {
-            case FANN_NETTYPE_LAYER: {
-                --count;
-                break;
-            }
-            case FANN_NETTYPE_SHORTCUT: {
-                /* The bias in the first layer is reused for all layers */
-                if (layer_it == ann->first_layer)
-                    --count;
-                break;
-            }
-            default: {
-                /* Unknown network type, assume no bias present  */
-                break;
-            }
-        }
-        *layers++ = count;
-    }
+	if(precision == FANN_PRECISION_INT8)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_USE_PRECISION);
+		return -1;
+	}
+	/* the weights of a loaded network may be mapped from configuration_file, which
+	   must not be truncated while they are written, so it is replaced instead */
+	file = fann_open_temporary_file((struct fann_error *) ann, configuration_file, "wb", &temporary_file);
+	if(!file)
+		return -1;
+	retval = fann_save_binary_fd(ann, file, configuration_file, precision);
+	return fann_replace_file((struct fann_error *) ann, file, temporary_file, configuration_file, retval);
 }
 
-FANN_EXTERNAL void FANN_API fann_get_bias_array(struct fann *ann, unsigned int *bias)
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_binary(const char *configuration_file)
 {
-    struct fann_layer *layer_it;
+	struct fann *ann;
+	FILE *file = fopen(configuration_file, "rb");
 
-    for (layer_it = ann->first_layer; layer_it != ann->last_layer; ++layer_it, ++bias) {
-        switch (fann_get_network_type(ann)) {
-            case FANN_NETTYPE_LAYER: {
-                /* Report one bias in each layer except the last */
-                if (layer_it != ann->last_layer-1)
-                    *bias = 1;
-                else
-                    *bias = 0;
-                break;
-            }
-            case FANN_NETTYPE_SHORTCUT: {
-                /* The bias in the first layer is reused for all layers */
-                if (layer_it == ann->first_layer)
-                    *bias = 1;
-                else
-                    *bias = 0;
-                break;
-            }
-            default: {
-                /* Unknown network type, assume no bias present  */
-                *bias = 0;
-                break;
-            }
-        }
-    }
+	if(!file)
+	{
+		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
+		return NULL;
+	}
+	ann = fann_create_from_binary_fd(file, configuration_file);
+	fclose(file);
+	return ann;
 }
 
-FANN_EXTERNAL void FANN_API fann_get_connection_array(struct fann *ann, struct fann_connection *connections)
+/* INTERNAL FUNCTION
+   Writes the network as fann_save_binary does at the current position of file, which must
+   be a multiple of FANN_BINARY_ALIGNMENT. The offsets in the header are relative to that
+   position and its last field is the size of the network, so several networks can follow
+   each other in one file. Leaves the file at the end of the network.
+ */
+int fann_save_binary_fd(struct fann *ann, FILE *file, const char *configuration_file,
+						enum fann_precision_enum precision)
 {
-    struct fann_neuron *first_neuron;
-    struct fann_layer *layer_it;
-    struct fann_neuron *neuron_it;
-    unsigned int idx;
-    unsigned int source_index;
-    unsigned int destination_index;
-
-    first_neuron = ann->first_layer->first_neuron;
+	unsigned char header[FANN_BINARY_HEADER_SIZE];
+	uint32_t sources[1024];
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	long start, structure_size, connections_offset, weights_offset, end;
+	unsigned int i, j, num;
+	unsigned int num_kept = fann_get_total_active_connections(ann);
+	unsigned int weight_size = sizeof(fann_type);
+	int retval = 0;
 
-    source_index = 0;
-    destination_index = 0;
+	if(precision == FANN_PRECISION_FLOAT)
+		weight_size = sizeof(float);
+	else if(precision == FANN_PRECISION_HALF || precision == FANN_PRECISION_BFLOAT16)
+		weight_size = sizeof(uint16_t);
 
-    /* The following assumes that the last unused bias has no connections */
+	start = ftell(file);
+	if(start < 0 || start % FANN_BINARY_ALIGNMENT != 0)
+		retval = -1;
 
-    /* for each layer */
-    for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++){
-        /* for each neuron */
-        for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++){
-            /* for each connection */
-            for (idx = neuron_it->first_con; idx < neuron_it->last_con; idx++){
-                /* Assign the source, destination and weight */
-                connections->from_neuron = (unsigned int)(ann->connections[source_index] - first_neuron);
-                connections->to_neuron = destination_index;
-                connections->weight = ann->weights[source_index];
+	/* the header is written last, once the offsets are known */
+	memset(header, 0, sizeof(header));
+	if(retval == 0 && fwrite(header, 1, sizeof(header), file) != sizeof(header))
+		retval = -1;
 
-                connections++;
-                source_index++;
-            }
-            destination_index++;
-        }
-    }
+	if(retval == 0)
+	{
+		fann_save_internal_fd(ann, file, configuration_file, 0, 0);
+		structure_size = ftell(file) - start - FANN_BINARY_HEADER_SIZE;
+		retval = fann_write_binary_padding(file, &connections_offset);
+	}
+	if(retval == 0 && num_kept < ann->total_connections)
+		retval = fann_write_sparse_connections(ann, file);
+	for(i = 0; retval == 0 && num_kept == ann->total_connections && i < ann->total_connections; i += num)
+	{
+		num = ann->total_connections - i < 1024 ? ann->total_connections - i : 1024;
+		for(j = 0; j != num; j++)
+		{
+			sources[j] = (uint32_t) (ann->connections[i + j] - first_neuron);
+		}
+		retval = fann_write_le_array(file, sources, sizeof(uint32_t), num);
+	}
+
+	if(retval == 0)
+		retval = fann_write_binary_padding(file, &weights_offset);
+	if(retval == 0)
+		retval = fann_write_binary_weights(file, ann->weights, num_kept < ann->total_connections ? ann->connection_mask : NULL,
+										   ann->total_connections, precision);
+
+	if(retval == 0)
+	{
+		end = ftell(file);
+		memcpy(header, FANN_BINARY_MAGIC, 8);
+		fann_write_le(header + 8, FANN_BINARY_VERSION, 4);
+		fann_write_le(header + 12, weight_size, 2);
+		fann_write_le(header + 14, precision == FANN_PRECISION_BFLOAT16, 2);
+		fann_write_le(header + 16, FANN_BINARY_HEADER_SIZE, 8);
+		fann_write_le(header + 24, (uint64_t) structure_size, 8);
+		fann_write_le(header + 32, (uint64_t) (connections_offset - start), 8);
+		fann_write_le(header + 40, (uint64_t) (weights_offset - start), 8);
+		fann_write_le(header + 48, ann->total_connections, 4);
+		fann_write_le(header + 52, num_kept, 4);
+		fann_write_le(header + 56, (uint64_t) (end - start), 8);
+		if(fseek(file, start, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), file) != sizeof(header) ||
+		   fseek(file, end, SEEK_SET) != 0)
+			retval = -1;
+	}
+
+	if(retval != 0)
+		fann_error((struct fann_error *) ann, FANN_E_CANT_OPEN_CONFIG_W, configuration_file);
+	return retval;
 }
 
-FANN_EXTERNAL void FANN_API fann_set_weight_array(struct fann *ann,
-    struct fann_connection *connections, unsigned int num_connections)
+/* INTERNAL FUNCTION
+   Reads a network written by fann_save_binary_fd at the current position of file, and
+   leaves the file at the end of the network. The weights of a network without pruned
+   connections are mapped from the file when they can be, and the mapping outlives the file.
+ */
+struct fann *fann_create_from_binary_fd(FILE *file, const char *configuration_file)
 {
-    unsigned int idx;
-
-    for (idx = 0; idx < num_connections; idx++) {
-        fann_set_weight(ann, connections[idx].from_neuron,
-            connections[idx].to_neuron, connections[idx].weight);
-    }
-}
+	unsigned char header[FANN_BINARY_HEADER_SIZE];
+	uint32_t sources[1024];
+	unsigned char *encoded;
+	uint64_t structure_offset, connections_offset, weights_offset, num_connections, num_kept, size;
+	unsigned int version, weight_size, bfloat16, i, j, num;
+	struct fann_neuron *first_neuron;
+	struct fann *ann;
+	long start = ftell(file), length;
 
-FANN_EXTERNAL void FANN_API fann_set_weight(struct fann *ann,
-    unsigned int from_neuron, unsigned int to_neuron, fann_type weight)
-{
-    struct fann_neuron *first_neuron;
-    struct fann_layer *layer_it;
-    struct fann_neuron *neuron_it;
-    unsigned int idx;
-    unsigned int source_index;
-    unsigned int destination_index;
+	if(start < 0 || fread(header, 1, sizeof(header), file) != sizeof(header) ||
+	   memcmp(header, FANN_BINARY_MAGIC, 8) != 0)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, "header", configuration_file);
+		return NULL;
+	}
+	version = (unsigned int) fann_read_le(header + 8, 4);
+	/* version 1 has a 4 byte weight size, the high bytes of which are 0 like the bfloat16 flag */
+	weight_size = (unsigned int) fann_read_le(header + 12, 2);
+	bfloat16 = (unsigned int) fann_read_le(header + 14, 2);
+	if(version < 1 || version > FANN_BINARY_VERSION || (weight_size != 2 && weight_size != 4 && weight_size != 8) ||
+	   (bfloat16 != 0 && weight_size != 2))
+	{
+		fann_error(NULL, FANN_E_WRONG_CONFIG_VERSION, configuration_file);
+		return NULL;
+	}
+	structure_offset = fann_read_le(header + 16, 8);
+	connections_offset = fann_read_le(header + 32, 8);
+	weights_offset = fann_read_le(header + 40, 8);
+	/* version 1 has no pruned connections, and 8 bytes for the number of connections */
+	num_connections = fann_read_le(header + 48, version == 1 ? 8 : 4);
+	num_kept = version == 1 ? num_connections : fann_read_le(header + 52, 4);
+	size = fann_read_le(header + 56, 8);
+
+	/* the file must be complete, so the mapping covers all the weights. The fields are not
+	   trusted, each is compared with what is left of the file so that no sum can wrap. */
+	if(fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < start)
+		length = -1;
+	if(length < 0 || size > (uint64_t) (length - start) || structure_offset < FANN_BINARY_HEADER_SIZE ||
+	   structure_offset > size || connections_offset > size || weights_offset > size ||
+	   connections_offset > weights_offset || num_kept > num_connections ||
+	   num_kept > (size - weights_offset) / weight_size ||
+	   (num_kept == num_connections && num_connections > (weights_offset - connections_offset) / sizeof(uint32_t)) ||
+	   fseek(file, (long) (start + structure_offset), SEEK_SET) != 0)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, "header", configuration_file);
+		return NULL;
+	}
 
-    first_neuron = ann->first_layer->first_neuron;
+	ann = fann_create_from_fd(file, configuration_file, 0);
+	if(ann == NULL)
+		return NULL;
+	if(ann->total_connections != num_connections ||
+	   fseek(file, (long) (start + connections_offset), SEEK_SET) != 0)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONNECTIONS, configuration_file);
+		fann_destroy(ann);
+		return NULL;
+	}
 
-    source_index = 0;
-    destination_index = 0;
+	if(num_kept < num_connections)
+	{
+		/* the sparse encoding is small, it is read at once and decoded into the connection mask */
+		size_t encoded_size = (size_t) (weights_offset - connections_offset);
 
-    /* Find the connection, simple brute force search through the network
-       for one or more connections that match to minimize datastructure dependencies.
-       Nothing is done if the connection does not already exist in the network. */
+		encoded = (unsigned char *) malloc(encoded_size > 0 ? encoded_size : 1);
+		if(encoded == NULL)
+		{
+			fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+			fann_destroy(ann);
+			return NULL;
+		}
+		if(fread(encoded, 1, encoded_size, file) != encoded_size ||
+		   fann_read_sparse_connections(ann, encoded, encoded_size, (unsigned int) num_kept) != 0)
+			i = 0;
+		else
+			i = ann->total_connections;
+		free(encoded);
+	}
+	else
+	{
+		first_neuron = ann->first_layer->first_neuron;
+		for(i = 0; i < ann->total_connections; i += num)
+		{
+			num = ann->total_connections - i < 1024 ? ann->total_connections - i : 1024;
+			if(fread(sources, sizeof(uint32_t), num, file) != num)
+				break;
+			if(!fann_is_little_endian())
+				fann_swap_bytes(sources, sizeof(uint32_t), num);
+			for(j = 0; j != num && sources[j] < ann->total_neurons; j++)
+			{
+				ann->connections[i + j] = first_neuron + sources[j];
+			}
+			if(j != num)
+				break;
+		}
+	}
+	if(i < ann->total_connections)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONNECTIONS, configuration_file);
+		fann_destroy(ann);
+		return NULL;
+	}
 
-    /* for each layer */
-    for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++){
-        /* for each neuron */
-        for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++){
-            /* for each connection */
-            for (idx = neuron_it->first_con; idx < neuron_it->last_con; idx++){
-                /* If the source and destination neurons match, assign the weight */
-                if (((int)from_neuron == ann->connections[source_index] - first_neuron) &&
-                    (to_neuron == destination_index))
-                {
-                    ann->weights[source_index] = weight;
-                }
-                source_index++;
-            }
-            destination_index++;
-        }
-    }
-}
+#ifndef _WIN32
+	/* the mapped weights are used in place, so they must be aligned for fann_type */
+	if(fann_is_little_endian() && weight_size == sizeof(fann_type) && !bfloat16 && num_kept == num_connections &&
+	   ann->total_connections > 0 && (start + weights_offset) % sizeof(fann_type) == 0)
+	{
+		/* mmap needs an offset on a page boundary, the mapping starts at the one before the network */
+		long page_size = sysconf(_SC_PAGESIZE);
+		long map_start = page_size > 0 ? start - start % page_size : 0;
+		size_t map_size = (size_t) (start + size - map_start);
+		void *mapping = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), map_start);
 
-FANN_EXTERNAL void FANN_API fann_get_weights(struct fann *ann, fann_type *weights)
-{
-	memcpy(weights, ann->weights, sizeof(fann_type)*ann->total_connections);
-}
+		if(mapping != MAP_FAILED)
+		{
+			fann_safe_free(ann->weights);
+			ann->weights = (fann_type *) ((unsigned char *) mapping + (start - map_start) + weights_offset);
+			ann->weights_mapping = mapping;
+			ann->weights_mapping_size = map_size;
+			fseek(file, (long) (start + size), SEEK_SET);
+			return ann;
+		}
+	}
+#endif
 
-FANN_EXTERNAL void FANN_API fann_set_weights(struct fann *ann, fann_type *weights)
-{
-	memcpy(ann->weights, weights, sizeof(fann_type)*ann->total_connections);
+	/* without mmap the weights are read, and converted when they have another size */
+	if(fseek(file, (long) (start + weights_offset), SEEK_SET) != 0 ||
+	   fann_read_binary_weights(file, ann->weights, (unsigned int) num_kept, weight_size, bfloat16) != num_kept)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONNECTIONS, configuration_file);
+		fann_destroy(ann);
+		return NULL;
+	}
+	if(num_kept < num_connections)
+	{
+		/* the kept weights are at the start, they move to their connections from the last one */
+		for(i = ann->total_connections, j = (unsigned int) num_kept; i-- > 0;)
+		{
+			ann->weights[i] = ann->connection_mask[i] != 0 ? ann->weights[--j] : 0;
+		}
+	}
+	fseek(file, (long) (start + size), SEEK_SET);
+	return ann;
 }
 
-FANN_GET_SET(void *, user_data)
-
-#ifdef FIXEDFANN
-
-FANN_GET(unsigned int, decimal_point)
-FANN_GET(unsigned int, multiplier)
-
-/* INTERNAL FUNCTION
-   Adjust the steepwise functions (if used)
-*/
-void fann_update_stepwise(struct fann *ann)
+FANN_EXTERNAL int FANN_API fann_save_bundle(const char *bundle_file, struct fann **anns,
+											unsigned int num_anns, const char *metadata,
+											enum fann_precision_enum precision)
 {
-	unsigned int i = 0;
+	unsigned char header[FANN_BINARY_HEADER_SIZE];
+	unsigned char offset[8];
+	char *temporary_file;
+	long metadata_offset, *offsets, file_size;
+	size_t metadata_size = metadata != NULL ? strlen(metadata) : 0;
+	unsigned int i;
+	int retval = 0;
+	FILE *file;
 
-	/* Calculate the parameters for the stepwise linear
-	 * sigmoid function fixed point.
-	 * Using a rewritten sigmoid function.
-	 * results 0.005, 0.05, 0.25, 0.75, 0.95, 0.995
-	 */
-	ann->sigmoid_results[0] = fann_max((fann_type) (ann->multiplier / 200.0 + 0.5), 1);
-	ann->sigmoid_results[1] = fann_max((fann_type) (ann->multiplier / 20.0 + 0.5), 1);
-	ann->sigmoid_results[2] = fann_max((fann_type) (ann->multiplier / 4.0 + 0.5), 1);
-	ann->sigmoid_results[3] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 4.0 + 0.5), ann->multiplier - 1);
-	ann->sigmoid_results[4] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 20.0 + 0.5), ann->multiplier - 1);
-	ann->sigmoid_results[5] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 200.0 + 0.5), ann->multiplier - 1);
+	if(precision == FANN_PRECISION_INT8)
+	{
+		fann_error(NULL, FANN_E_CANT_USE_PRECISION);
+		return -1;
+	}
+	offsets = (long *) calloc(num_anns + 1, sizeof(long));
+	if(offsets == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+	file = fann_open_temporary_file(NULL, bundle_file, "wb", &temporary_file);
+	if(!file)
+	{
+		free(offsets);
+		return -1;
+	}
 
-	ann->sigmoid_symmetric_results[0] = fann_max((fann_type) ((ann->multiplier / 100.0) - ann->multiplier - 0.5),
-				                                 (fann_type) (1 - (fann_type) ann->multiplier));
-	ann->sigmoid_symmetric_results[1] =	fann_max((fann_type) ((ann->multiplier / 10.0) - ann->multiplier - 0.5),
-				                                 (fann_type) (1 - (fann_type) ann->multiplier));
-	ann->sigmoid_symmetric_results[2] =	fann_max((fann_type) ((ann->multiplier / 2.0) - ann->multiplier - 0.5),
-                                				 (fann_type) (1 - (fann_type) ann->multiplier));
-	ann->sigmoid_symmetric_results[3] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 2.0 + 0.5),
-				 							     ann->multiplier - 1);
-	ann->sigmoid_symmetric_results[4] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 10.0 + 0.5),
-				 							     ann->multiplier - 1);
-	ann->sigmoid_symmetric_results[5] = fann_min(ann->multiplier - (fann_type) (ann->multiplier / 100.0 + 1.0),
-				 							     ann->multiplier - 1);
+	/* the header and the offsets of the networks are written last, once they are known */
+	memset(header, 0, sizeof(header));
+	if(fwrite(header, 1, sizeof(header), file) != sizeof(header))
+		retval = -1;
+	for(i = 0; retval == 0 && i != num_anns; i++)
+	{
+		if(fwrite(header, 1, 8, file) != 8)
+			retval = -1;
+	}
+	metadata_offset = ftell(file);
+	if(retval == 0 && metadata_size > 0 && fwrite(metadata, 1, metadata_size, file) != metadata_size)
+		retval = -1;
+	for(i = 0; retval == 0 && i != num_anns; i++)
+	{
+		retval = fann_write_binary_padding(file, offsets + i);
+		if(retval == 0)
+			retval = fann_save_binary_fd(anns[i], file, temporary_file, precision);
+	}
 
-	for(i = 0; i < 6; i++)
+	if(retval == 0)
 	{
-		ann->sigmoid_values[i] =
-			(fann_type) (((log(ann->multiplier / (float) ann->sigmoid_results[i] - 1) *
-						   (float) ann->multiplier) / -2.0) * (float) ann->multiplier);
-		ann->sigmoid_symmetric_values[i] =
-			(fann_type) (((log
-						   ((ann->multiplier -
-							 (float) ann->sigmoid_symmetric_results[i]) /
-							((float) ann->sigmoid_symmetric_results[i] +
-							 ann->multiplier)) * (float) ann->multiplier) / -2.0) *
-						 (float) ann->multiplier);
+		file_size = ftell(file);
+		memcpy(header, FANN_BUNDLE_MAGIC, 8);
+		fann_write_le(header + 8, FANN_BUNDLE_VERSION, 4);
+		fann_write_le(header + 12, num_anns, 4);
+		fann_write_le(header + 16, (uint64_t) metadata_offset, 8);
+		fann_write_le(header + 24, metadata_size, 8);
+		fann_write_le(header + 32, FANN_BINARY_HEADER_SIZE, 8);
+		fann_write_le(header + 40, (uint64_t) file_size, 8);
+		if(fseek(file, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), file) != sizeof(header))
+			retval = -1;
+		for(i = 0; retval == 0 && i != num_anns; i++)
+		{
+			fann_write_le(offset, (uint64_t) offsets[i], 8);
+			if(fwrite(offset, 1, 8, file) != 8)
+				retval = -1;
+		}
 	}
+	free(offsets);
+	return fann_replace_file(NULL, file, temporary_file, bundle_file, retval);
 }
-#endif
 
-
-/* INTERNAL FUNCTION
-   Allocates the main structure and sets some default values.
- */
-struct fann *fann_allocate_structure(unsigned int num_layers)
+FANN_EXTERNAL unsigned int FANN_API fann_create_from_bundle(const char *bundle_file, struct fann **anns,
+															unsigned int max_anns, char **metadata)
 {
-	struct fann *ann;
+	unsigned char header[FANN_BINARY_HEADER_SIZE];
+	unsigned char offset[8];
+	uint64_t metadata_offset, metadata_size, table_offset, file_size, length;
+	uint64_t *offsets = NULL;
+	char *read_metadata = NULL;
+	unsigned int num_anns, i, num_read = 0;
+	long end;
+	FILE *file = fopen(bundle_file, "rb");
 
-	if(num_layers < 2)
+	if(metadata != NULL)
+		*metadata = NULL;
+	if(!file)
 	{
-#ifdef DEBUG
-		printf("less than 2 layers - ABORTING.\n");
-#endif
-		return NULL;
+		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, bundle_file);
+		return 0;
 	}
 
-	/* allocate and initialize the main network structure */
-	ann = (struct fann *) malloc(sizeof(struct fann));
-	if(ann == NULL)
+	if(fread(header, 1, sizeof(header), file) != sizeof(header) ||
+	   memcmp(header, FANN_BUNDLE_MAGIC, 8) != 0)
 	{
-		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
-		return NULL;
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, "header", bundle_file);
+		fclose(file);
+		return 0;
+	}
+	if(fann_read_le(header + 8, 4) != FANN_BUNDLE_VERSION)
+	{
+		fann_error(NULL, FANN_E_WRONG_CONFIG_VERSION, bundle_file);
+		fclose(file);
+		return 0;
+	}
+	num_anns = (unsigned int) fann_read_le(header + 12, 4);
+	metadata_offset = fann_read_le(header + 16, 8);
+	metadata_size = fann_read_le(header + 24, 8);
+	table_offset = fann_read_le(header + 32, 8);
+	file_size = fann_read_le(header + 40, 8);
+
+	/* the header is not trusted, its sizes are checked against the actual file without any
+	   sum that could wrap, which also bounds the metadata allocated below */
+	end = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+	length = end > 0 ? (uint64_t) end : 0;
+	if(num_anns > max_anns || length < FANN_BINARY_HEADER_SIZE || file_size > length || metadata_size > length ||
+	   metadata_offset > length - metadata_size || table_offset > length ||
+	   num_anns > (length - table_offset) / 8 || fseek(file, (long) table_offset, SEEK_SET) != 0)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, "header", bundle_file);
+		fclose(file);
+		return 0;
 	}
 
-	ann->errno_f = FANN_E_NO_ERROR;
-	ann->error_log = fann_default_error_log;
-	ann->errstr = NULL;
-	ann->learning_rate = 0.7f;
-	ann->learning_momentum = 0.0;
-	ann->total_neurons = 0;
-	ann->total_connections = 0;
-	ann->num_input = 0;
-	ann->num_output = 0;
-	ann->train_errors = NULL;
-	ann->train_slopes = NULL;
-	ann->prev_steps = NULL;
-	ann->prev_train_slopes = NULL;
-	ann->prev_weights_deltas = NULL;
-	ann->training_algorithm = FANN_TRAIN_RPROP;
-	ann->num_MSE = 0;
-	ann->MSE_value = 0;
-	ann->num_bit_fail = 0;
-	ann->bit_fail_limit = (fann_type)0.35;
-	ann->network_type = FANN_NETTYPE_LAYER;
-	ann->train_error_function = FANN_ERRORFUNC_TANH;
-	ann->train_stop_function = FANN_STOPFUNC_MSE;
-	ann->callback = NULL;
-    ann->user_data = NULL; /* User is responsible for deallocation */
-	ann->weights = NULL;
-	ann->connections = NULL;
-	ann->output = NULL;
-#ifndef FIXEDFANN
-	ann->scale_mean_in = NULL;
-	ann->scale_deviation_in = NULL;
-	ann->scale_new_min_in = NULL;
-	ann->scale_factor_in = NULL;
-	ann->scale_mean_out = NULL;
-	ann->scale_deviation_out = NULL;
-	ann->scale_new_min_out = NULL;
-	ann->scale_factor_out = NULL;
-#endif
-
-	/* variables used for cascade correlation (reasonable defaults) */
-	ann->cascade_output_change_fraction = 0.01f;
-	ann->cascade_candidate_change_fraction = 0.01f;
-	ann->cascade_output_stagnation_epochs = 12;
-	ann->cascade_candidate_stagnation_epochs = 12;
-	ann->cascade_num_candidate_groups = 2;
-	ann->cascade_weight_multiplier = (fann_type)0.4;
-	ann->cascade_candidate_limit = (fann_type)1000.0;
-	ann->cascade_max_out_epochs = 150;
-	ann->cascade_max_cand_epochs = 150;
-	ann->cascade_min_out_epochs = 50;
-	ann->cascade_min_cand_epochs = 50;
-	ann->cascade_candidate_scores = NULL;
-	ann->cascade_activation_functions_count = 10;
-	ann->cascade_activation_functions =
-		(enum fann_activationfunc_enum *)calloc(ann->cascade_activation_functions_count,
-							   sizeof(enum fann_activationfunc_enum));
-	if(ann->cascade_activation_functions == NULL)
+	offsets = (uint64_t *) malloc((num_anns + 1) * sizeof(uint64_t));
+	read_metadata = (char *) malloc((size_t) metadata_size + 1);
+	if(offsets == NULL || read_metadata == NULL)
 	{
 		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
-		free(ann);
-		return NULL;
+		num_anns = 0;
 	}
+	for(i = 0; i < num_anns; i++)
+	{
+		if(fread(offset, 1, 8, file) != 8)
+			break;
+		offsets[i] = fann_read_le(offset, 8);
+		/* fann_create_from_binary_fd checks the rest of the network against the file */
+		if(offsets[i] > length - FANN_BINARY_HEADER_SIZE)
+			break;
+	}
+	if(i == num_anns && read_metadata != NULL &&
+	   fseek(file, (long) metadata_offset, SEEK_SET) == 0 &&
+	   fread(read_metadata, 1, (size_t) metadata_size, file) == metadata_size)
+	{
+		read_metadata[metadata_size] = '\0';
+		for(num_read = 0; num_read != num_anns; num_read++)
+		{
+			if(fseek(file, (long) offsets[num_read], SEEK_SET) != 0)
+				break;
+			anns[num_read] = fann_create_from_binary_fd(file, bundle_file);
+			if(anns[num_read] == NULL)
+				break;
+		}
+	}
+	fclose(file);
+	fann_safe_free(offsets);
 
-	ann->cascade_activation_functions[0] = FANN_SIGMOID;
-	ann->cascade_activation_functions[1] = FANN_SIGMOID_SYMMETRIC;
-	ann->cascade_activation_functions[2] = FANN_GAUSSIAN;
-	ann->cascade_activation_functions[3] = FANN_GAUSSIAN_SYMMETRIC;
-	ann->cascade_activation_functions[4] = FANN_ELLIOT;
-	ann->cascade_activation_functions[5] = FANN_ELLIOT_SYMMETRIC;
-	ann->cascade_activation_functions[6] = FANN_SIN_SYMMETRIC;
-	ann->cascade_activation_functions[7] = FANN_COS_SYMMETRIC;
-	ann->cascade_activation_functions[8] = FANN_SIN;
-	ann->cascade_activation_functions[9] = FANN_COS;
-
-	ann->cascade_activation_steepnesses_count = 4;
-	ann->cascade_activation_steepnesses =
-		(fann_type *)calloc(ann->cascade_activation_steepnesses_count,
-							   sizeof(fann_type));
-	if(ann->cascade_activation_steepnesses == NULL)
+	/* all the networks or none */
+	if(read_metadata == NULL || num_read != num_anns || num_anns == 0)
 	{
-		fann_safe_free(ann->cascade_activation_functions);
-		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
-		free(ann);
-		return NULL;
+		if(num_anns != 0 && num_read == 0)
+			fann_error(NULL, FANN_E_CANT_READ_CONFIG, "networks", bundle_file);
+		while(num_read > 0)
+		{
+			num_read--;
+			fann_destroy(anns[num_read]);
+			anns[num_read] = NULL;
+		}
+		fann_safe_free(read_metadata);
+		return 0;
 	}
 
-	ann->cascade_activation_steepnesses[0] = (fann_type)0.25;
-	ann->cascade_activation_steepnesses[1] = (fann_type)0.5;
-	ann->cascade_activation_steepnesses[2] = (fann_type)0.75;
-	ann->cascade_activation_steepnesses[3] = (fann_type)1.0;
+	if(metadata != NULL)
+		*metadata = read_metadata;
+	else
+		free(read_metadata);
+	return num_anns;
+}
 
-	/* Variables for use with with Quickprop training (reasonable defaults) */
-	ann->quickprop_decay = -0.0001f;
-	ann->quickprop_mu = 1.75;
+#endif
 
-	/* Variables for use with with RPROP training (reasonable defaults) */
-	ann->rprop_increase_factor = 1.2f;
-	ann->rprop_decrease_factor = 0.5;
-	ann->rprop_delta_min = 0.0;
-	ann->rprop_delta_max = 50.0;
-	ann->rprop_delta_zero = 0.1f;
+#ifndef FIXEDFANN
 
- 	/* Variables for use with SARPROP training (reasonable defaults) */
- 	ann->sarprop_weight_decay_shift = -6.644f;
- 	ann->sarprop_step_error_threshold_factor = 0.1f;
- 	ann->sarprop_step_error_shift = 1.385f;
- 	ann->sarprop_temperature = 0.015f;
- 	ann->sarprop_epoch = 0;
+FANN_EXTERNAL int FANN_API fann_save_checkpoint(struct fann *ann, const char *configuration_file)
+{
+	char *temporary_file;
+	FILE *file;
+	int retval;
 
-	fann_init_error_data((struct fann_error *) ann);
+	file = fann_open_temporary_file((struct fann_error *) ann, configuration_file, "w", &temporary_file);
+	if(!file)
+		return -1;
+	retval = fann_save_checkpoint_internal_fd(ann, file, temporary_file);
+	return fann_replace_file((struct fann_error *) ann, file, temporary_file, configuration_file, retval);
+}
 
-#ifdef FIXEDFANN
-	/* these values are only boring defaults, and should really
-	 * never be used, since the real values are always loaded from a file. */
-	ann->decimal_point = 8;
-	ann->multiplier = 256;
-#endif
+FANN_EXTERNAL int FANN_API fann_save_checkpoint_to_fd(struct fann *ann, FILE *file)
+{
+	return fann_save_checkpoint_internal_fd(ann, file, "checkpoint");
+}
 
-	/* allocate room for the layers */
-	ann->first_layer = (struct fann_layer *) calloc(num_layers, sizeof(struct fann_layer));
-	if(ann->first_layer == NULL)
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_checkpoint(const char *configuration_file)
+{
+	struct fann *ann;
+	FILE *file = fopen(configuration_file, "r");
+
+	if(!file)
 	{
-		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
-		free(ann);
+		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
 		return NULL;
 	}
-
-	ann->last_layer = ann->first_layer + num_layers;
-
+	ann = fann_create_from_checkpoint_internal_fd(file, configuration_file);
+	fclose(file);
 	return ann;
 }
 
-/* INTERNAL FUNCTION
-   Allocates room for the scaling parameters.
- */
-int fann_allocate_scale(struct fann *ann)
+FANN_EXTERNAL struct fann *FANN_API fann_create_from_checkpoint_fd(FILE *file)
 {
-	/* todo this should only be allocated when needed */
-#ifndef FIXEDFANN
-	unsigned int i = 0;
-#define SCALE_ALLOCATE( what, where, default_value )		    			\
-		ann->what##_##where = (float *)calloc(								\
-			ann->num_##where##put,											\
-			sizeof( float )													\
-			);																\
-		if( ann->what##_##where == NULL )									\
-		{																	\
-			fann_error( NULL, FANN_E_CANT_ALLOCATE_MEM );					\
-			fann_destroy( ann );                            				\
-			return 1;														\
-		}																	\
-		for( i = 0; i < ann->num_##where##put; i++ )						\
-			ann->what##_##where[ i ] = ( default_value );
-
-	SCALE_ALLOCATE( scale_mean,		in,		0.0 )
-	SCALE_ALLOCATE( scale_deviation,	in,		1.0 )
-	SCALE_ALLOCATE( scale_new_min,	in,		-1.0 )
-	SCALE_ALLOCATE( scale_factor,		in,		1.0 )
-
-	SCALE_ALLOCATE( scale_mean,		out,	0.0 )
-	SCALE_ALLOCATE( scale_deviation,	out,	1.0 )
-	SCALE_ALLOCATE( scale_new_min,	out,	-1.0 )
-	SCALE_ALLOCATE( scale_factor,		out,	1.0 )
-#undef SCALE_ALLOCATE
-#endif
-	return 0;
+	return fann_create_from_checkpoint_internal_fd(file, "checkpoint");
 }
 
 /* INTERNAL FUNCTION
-   Allocates room for the neurons.
+   Writes the network as fann_save does, followed by the state of the training. Floats and
+   fann_type values are written with all their digits, so they are read back unchanged.
  */
-void fann_allocate_neurons(struct fann *ann)
+int fann_save_checkpoint_internal_fd(struct fann *ann, FILE *file, const char *configuration_file)
 {
-	struct fann_layer *layer_it;
-	struct fann_neuron *neurons;
-	unsigned int num_neurons_so_far = 0;
-	unsigned int num_neurons = 0;
-
-	/* all the neurons is allocated in one long array (calloc clears mem) */
-	neurons = (struct fann_neuron *) calloc(ann->total_neurons, sizeof(struct fann_neuron));
-	ann->total_neurons_allocated = ann->total_neurons;
-
-	if(neurons == NULL)
-	{
-		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
-		return;
+	unsigned int i;
+	unsigned int num_layers = (unsigned int) (ann->last_layer - ann->first_layer);
+
+	fann_save_internal_fd(ann, file, configuration_file, 0, 1);
+
+	fprintf(file, "checkpoint_version=1\n");
+	fprintf(file, "learning_rate=%.9e\n", ann->learning_rate);
+	fprintf(file, "learning_momentum=%.9e\n", ann->learning_momentum);
+	fprintf(file, "activation_approximation=%u\n", ann->activation_approximation);
+	fprintf(file, "num_threads=%u\n", ann->num_threads);
+	fprintf(file, "batch_size=%u\n", ann->batch_size);
+	fprintf(file, "quickprop_decay=%.9e\n", ann->quickprop_decay);
+	fprintf(file, "quickprop_mu=%.9e\n", ann->quickprop_mu);
+	fprintf(file, "rprop_increase_factor=%.9e\n", ann->rprop_increase_factor);
+	fprintf(file, "rprop_decrease_factor=%.9e\n", ann->rprop_decrease_factor);
+	fprintf(file, "rprop_delta_min=%.9e\n", ann->rprop_delta_min);
+	fprintf(file, "rprop_delta_max=%.9e\n", ann->rprop_delta_max);
+	fprintf(file, "rprop_delta_zero=%.9e\n", ann->rprop_delta_zero);
+	fprintf(file, "sarprop_weight_decay_shift=%.9e\n", ann->sarprop_weight_decay_shift);
+	fprintf(file, "sarprop_step_error_threshold_factor=%.9e\n", ann->sarprop_step_error_threshold_factor);
+	fprintf(file, "sarprop_step_error_shift=%.9e\n", ann->sarprop_step_error_shift);
+	fprintf(file, "sarprop_temperature=%.9e\n", ann->sarprop_temperature);
+	fprintf(file, "sarprop_epoch=%u\n", ann->sarprop_epoch);
+	fprintf(file, "adam_beta1=%.9e\n", ann->adam_beta1);
+	fprintf(file, "adam_beta2=%.9e\n", ann->adam_beta2);
+	fprintf(file, "adam_epsilon=%.9e\n", ann->adam_epsilon);
+	fprintf(file, "adam_weight_decay=%.9e\n", ann->adam_weight_decay);
+	fprintf(file, "adam_timestep=%u\n", ann->adam_timestep);
+
+	fann_save_checkpoint_array(file, "train_slopes", ann->train_slopes, ann->total_connections);
+	fann_save_checkpoint_array(file, "prev_steps", ann->prev_steps, ann->total_connections);
+	fann_save_checkpoint_array(file, "prev_train_slopes", ann->prev_train_slopes, ann->total_connections);
+	fann_save_checkpoint_array(file, "prev_weights_deltas", ann->prev_weights_deltas, ann->total_connections);
+
+	/* the mask is 0 or 1, one digit per connection is enough */
+	fprintf(file, "connection_mask_included=%u\n", ann->connection_mask != NULL);
+	if(ann->connection_mask != NULL)
+	{
+		fprintf(file, "connection_mask=");
+		for(i = 0; i != ann->total_connections; i++)
+			fputc(ann->connection_mask[i] != 0 ? '1' : '0', file);
+		fprintf(file, "\n");
 	}
 
-	for(layer_it = ann->first_layer; layer_it != ann->last_layer; layer_it++)
+	fprintf(file, "values_int8_scale_included=%u\n", ann->values_int8_scale != NULL);
+	if(ann->values_int8_scale != NULL)
 	{
-		num_neurons = (unsigned int)(layer_it->last_neuron - layer_it->first_neuron);
-		layer_it->first_neuron = neurons + num_neurons_so_far;
-		layer_it->last_neuron = layer_it->first_neuron + num_neurons;
-		num_neurons_so_far += num_neurons;
+		fprintf(file, "values_int8_scale=");
+		for(i = 0; i != num_layers; i++)
+			fprintf(file, "%.9e ", ann->values_int8_scale[i]);
+		fprintf(file, "\n");
 	}
+	fprintf(file, "precision=%u\n", ann->precision);
 
-	ann->output = (fann_type *) calloc(num_neurons, sizeof(fann_type));
-	if(ann->output == NULL)
+	if(ferror(file))
 	{
-		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
-		return;
+		fann_error((struct fann_error *) ann, FANN_E_CANT_OPEN_CONFIG_W, configuration_file);
+		return -1;
 	}
+	return 0;
 }
 
 /* INTERNAL FUNCTION
-   Allocate room for the connections.
+   Writes "name_included=0" for a NULL array, otherwise "name_included=1" and a line with the
+   first count values of the array.
  */
-void fann_allocate_connections(struct fann *ann)
+void fann_save_checkpoint_array(FILE *file, const char *name, const fann_type *array, unsigned int count)
 {
-	ann->weights = (fann_type *) calloc(ann->total_connections, sizeof(fann_type));
-	if(ann->weights == NULL)
-	{
-		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
-		return;
-	}
-	ann->total_connections_allocated = ann->total_connections;
+	unsigned int i;
 
-	/* TODO make special cases for all places where the connections
-	 * is used, so that it is not needed for fully connected networks.
-	 */
-	ann->connections =
-		(struct fann_neuron **) calloc(ann->total_connections_allocated,
-									   sizeof(struct fann_neuron *));
-	if(ann->connections == NULL)
-	{
-		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+	fprintf(file, "%s_included=%u\n", name, array != NULL);
+	if(array == NULL)
 		return;
-	}
-}
-
-#ifdef FANN_NO_SEED
-int FANN_SEED_RAND = 0;
-#else
-int FANN_SEED_RAND = 1;
-#endif
 
-FANN_EXTERNAL void FANN_API fann_disable_seed_rand()
-{
-    FANN_SEED_RAND = 0;
+	fprintf(file, "%s=", name);
+	for(i = 0; i != count; i++)
+		fprintf(file, FANNPRINTF " ", array[i]);
+	fprintf(file, "\n");
 }
 
-FANN_EXTERNAL void FANN_API fann_enable_seed_rand()
-{
-    FANN_SEED_RAND = 1;
+#define fann_checkpoint_scanf(type, name, val) \
+{ \
+	if(fscanf(file, name"=" type"\n", val) != 1) \
+	{ \
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, name, configuration_file); \
+		fann_destroy(ann); \
+		return NULL; \
+	} \
 }
 
 /* INTERNAL FUNCTION
-   Seed the random function.
+   Reads a checkpoint written by fann_save_checkpoint_internal_fd.
  */
-void fann_seed_rand(void) {
-#ifndef _WIN32
-	FILE *fp = fopen("/dev/urandom", "r");
-	unsigned int foo;
-	struct timeval t;
+struct fann *fann_create_from_checkpoint_internal_fd(FILE *file, const char *configuration_file)
+{
+	unsigned int i, version, included, num_layers, tmp_value;
+	int c;
+	struct fann *ann = fann_create_from_fd(file, configuration_file, 1);
 
-	if(!fp)
+	if(ann == NULL)
+		return NULL;
+	num_layers = (unsigned int) (ann->last_layer - ann->first_layer);
+
+	fann_checkpoint_scanf("%u", "checkpoint_version", &version);
+	if(version != 1)
 	{
-		gettimeofday(&t, NULL);
-		foo = t.tv_usec;
-#ifdef DEBUG
-		printf("unable to open /dev/urandom\n");
-#endif
+		fann_error(NULL, FANN_E_WRONG_CONFIG_VERSION, configuration_file);
+		fann_destroy(ann);
+		return NULL;
 	}
-	else
+	fann_checkpoint_scanf("%f", "learning_rate", &ann->learning_rate);
+	fann_checkpoint_scanf("%f", "learning_momentum", &ann->learning_momentum);
+	fann_checkpoint_scanf("%u", "activation_approximation", &tmp_value);
+	ann->activation_approximation = (enum fann_approximation_enum) tmp_value;
+	fann_checkpoint_scanf("%u", "num_threads", &ann->num_threads);
+	fann_checkpoint_scanf("%u", "batch_size", &ann->batch_size);
+	fann_checkpoint_scanf("%f", "quickprop_decay", &ann->quickprop_decay);
+	fann_checkpoint_scanf("%f", "quickprop_mu", &ann->quickprop_mu);
+	fann_checkpoint_scanf("%f", "rprop_increase_factor", &ann->rprop_increase_factor);
+	fann_checkpoint_scanf("%f", "rprop_decrease_factor", &ann->rprop_decrease_factor);
+	fann_checkpoint_scanf("%f", "rprop_delta_min", &ann->rprop_delta_min);
+	fann_checkpoint_scanf("%f", "rprop_delta_max", &ann->rprop_delta_max);
+	fann_checkpoint_scanf("%f", "rprop_delta_zero", &ann->rprop_delta_zero);
+	fann_checkpoint_scanf("%f", "sarprop_weight_decay_shift", &ann->sarprop_weight_decay_shift);
+	fann_checkpoint_scanf("%f", "sarprop_step_error_threshold_factor", &ann->sarprop_step_error_threshold_factor);
+	fann_checkpoint_scanf("%f", "sarprop_step_error_shift", &ann->sarprop_step_error_shift);
+	fann_checkpoint_scanf("%f", "sarprop_temperature", &ann->sarprop_temperature);
+	fann_checkpoint_scanf("%u", "sarprop_epoch", &ann->sarprop_epoch);
+	fann_checkpoint_scanf("%f", "adam_beta1", &ann->adam_beta1);
+	fann_checkpoint_scanf("%f", "adam_beta2", &ann->adam_beta2);
+	fann_checkpoint_scanf("%f", "adam_epsilon", &ann->adam_epsilon);
+	fann_checkpoint_scanf("%f", "adam_weight_decay", &ann->adam_weight_decay);
+	fann_checkpoint_scanf("%u", "adam_timestep", &ann->adam_timestep);
+
+	if(fann_read_checkpoint_array(ann, file, configuration_file, "train_slopes", &ann->train_slopes) == -1 ||
+	   fann_read_checkpoint_array(ann, file, configuration_file, "prev_steps", &ann->prev_steps) == -1 ||
+	   fann_read_checkpoint_array(ann, file, configuration_file, "prev_train_slopes", &ann->prev_train_slopes) == -1 ||
+	   fann_read_checkpoint_array(ann, file, configuration_file, "prev_weights_deltas", &ann->prev_weights_deltas) == -1)
 	{
-	        if(fread(&foo, sizeof(foo), 1, fp) != 1)
-	        {
-  		       gettimeofday(&t, NULL);
-		       foo = t.tv_usec;
-#ifdef DEBUG
-		       printf("unable to read from /dev/urandom\n");
-#endif
-		}
-		fclose(fp);
+		fann_destroy(ann);
+		return NULL;
 	}
-    if(FANN_SEED_RAND) {
-        srand(foo);
-    }
-#else
-	/* COMPAT_TIME REPLACEMENT */
-    if(FANN_SEED_RAND) {
-    	srand(GetTickCount());
-    }
-#endif
-}
-
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdarg.h>
-#include <string.h>
-#include <limits.h>
 
-/* Create a network from a configuration file.
- */
-FANN_EXTERNAL struct fann *FANN_API fann_create_from_file(const char *configuration_file)
-{
-	struct fann *ann;
-	FILE *conf = fopen(configuration_file, "r");
+	fann_checkpoint_scanf("%u", "connection_mask_included", &included);
+	if(included)
+	{
+		if(fann_allocate_connection_mask(ann) == -1)
+		{
+			fann_destroy(ann);
+			return NULL;
+		}
+		if(fscanf(file, "connection_mask=") != 0)
+		{
+			fann_error(NULL, FANN_E_CANT_READ_CONFIG, "connection_mask", configuration_file);
+			fann_destroy(ann);
+			return NULL;
+		}
+		for(i = 0; i != ann->total_connections; i++)
+		{
+			c = fgetc(file);
+			if(c != '0' && c != '1')
+			{
+				fann_error(NULL, FANN_E_CANT_READ_CONFIG, "connection_mask", configuration_file);
+				fann_destroy(ann);
+				return NULL;
+			}
+			ann->connection_mask[i] = (fann_type) (c - '0');
+		}
+		if(fgetc(file) != '\n')
+		{
+			fann_error(NULL, FANN_E_CANT_READ_CONFIG, "connection_mask", configuration_file);
+			fann_destroy(ann);
+			return NULL;
+		}
+		if(fann_update_active_connections(ann) == -1)
+		{
+			fann_destroy(ann);
+			return NULL;
+		}
+	}
 
-	if(!conf)
+	fann_checkpoint_scanf("%u", "values_int8_scale_included", &included);
+	if(included)
 	{
-		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
+		ann->values_int8_scale = (float *) malloc(num_layers * sizeof(float));
+		if(ann->values_int8_scale == NULL)
+		{
+			fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+			fann_destroy(ann);
+			return NULL;
+		}
+		if(fscanf(file, "values_int8_scale=") != 0)
+		{
+			fann_error(NULL, FANN_E_CANT_READ_CONFIG, "values_int8_scale", configuration_file);
+			fann_destroy(ann);
+			return NULL;
+		}
+		for(i = 0; i != num_layers; i++)
+		{
+			if(fscanf(file, "%f ", &ann->values_int8_scale[i]) != 1)
+			{
+				fann_error(NULL, FANN_E_CANT_READ_CONFIG, "values_int8_scale", configuration_file);
+				fann_destroy(ann);
+				return NULL;
+			}
+		}
+	}
+	fann_checkpoint_scanf("%u", "precision", &tmp_value);
+	if(tmp_value != FANN_PRECISION_DEFAULT && fann_set_precision(ann, (enum fann_precision_enum) tmp_value) == -1)
+	{
+		fann_destroy(ann);
 		return NULL;
 	}
-	ann = fann_create_from_fd(conf, configuration_file);
-	fclose(conf);
+
 	return ann;
 }
 
-/* Save the network.
- */
-FANN_EXTERNAL int FANN_API fann_save(struct fann *ann, const char *configuration_file)
-{
-	return fann_save_internal(ann, configuration_file, 0);
-}
+#undef fann_checkpoint_scanf
 
-/* Save the network as fixed point data.
+/* INTERNAL FUNCTION
+   Reads an array written by fann_save_checkpoint_array into *array, which is allocated with
+   room for total_connections_allocated values when the array was included. Returns -1 on error.
  */
-FANN_EXTERNAL int FANN_API fann_save_to_fixed(struct fann *ann, const char *configuration_file)
+int fann_read_checkpoint_array(struct fann *ann, FILE *file, const char *configuration_file,
+							   const char *name, fann_type **array)
 {
-	return fann_save_internal(ann, configuration_file, 1);
+	char format[64];
+	unsigned int i, included;
+
+	snprintf(format, sizeof(format), "%s_included=%%u\n", name);
+	if(fscanf(file, format, &included) != 1)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, name, configuration_file);
+		return -1;
+	}
+	if(!included)
+		return 0;
+
+	*array = (fann_type *) calloc(ann->total_connections_allocated, sizeof(fann_type));
+	if(*array == NULL)
+	{
+		fann_error(NULL, FANN_E_CANT_ALLOCATE_MEM);
+		return -1;
+	}
+
+	snprintf(format, sizeof(format), "%s=", name);
+	if(fscanf(file, format) != 0)
+	{
+		fann_error(NULL, FANN_E_CANT_READ_CONFIG, name, configuration_file);
+		return -1;
+	}
+	for(i = 0; i != ann->total_connections; i++)
+	{
+		if(fscanf(file, FANNSCANF " ", (*array) + i) != 1)
+		{
+			fann_error(NULL, FANN_E_CANT_READ_CONFIG, name, configuration_file);
+			return -1;
+		}
+	}
+	return 0;
 }
 
+#endif
+
 /* INTERNAL FUNCTION
    Used to save the network to a file.
  */
@@ -5895,16 +9859,18 @@ int fann_save_internal(struct fann *ann, const char *configuration_file, unsigne
 		fann_error((struct fann_error *) ann, FANN_E_CANT_OPEN_CONFIG_W, configuration_file);
 		return -1;
 	}
-	retval = fann_save_internal_fd(ann, conf, configuration_file, save_as_fixed);
+	retval = fann_save_internal_fd(ann, conf, configuration_file, save_as_fixed, 1);
 	fclose(conf);
 	return retval;
 }
 
 /* INTERNAL FUNCTION
-   Used to save the network to a file descriptor.
+   Used to save the network to a file descriptor. Without save_connections only the
+   parameters, layers and neurons are saved, for formats that store the connections
+   on their own.
  */
 int fann_save_internal_fd(struct fann *ann, FILE * conf, const char *configuration_file,
-						  unsigned int save_as_fixed)
+						  unsigned int save_as_fixed, unsigned int save_connections)
 {
 	struct fann_layer *layer_it;
 	int calculated_decimal_point = 0;
@@ -6124,6 +10090,9 @@ int fann_save_internal_fd(struct fann *ann, FILE * conf, const char *configurati
 	}
 	fprintf(conf, "\n");
 
+	if(!save_connections)
+		return calculated_decimal_point;
+
 	connected_neurons = ann->connections;
 	weights = ann->weights;
 	first_neuron = ann->first_layer->first_neuron;
@@ -6187,9 +10156,12 @@ struct fann *fann_create_from_fd_1_1(FILE * conf, const char *configuration_file
 }
 
 /* INTERNAL FUNCTION
-   Create a network from a configuration file descriptor.
+   Create a network from a configuration file descriptor. Without read_connections the
+   file stops after the neurons, and the connections and weights are allocated but left
+   for the caller to fill.
  */
-struct fann *fann_create_from_fd(FILE * conf, const char *configuration_file)
+struct fann *fann_create_from_fd(FILE * conf, const char *configuration_file,
+								 unsigned int read_connections)
 {
 	unsigned int num_layers, layer_size, input_neuron, i, num_connections;
 	unsigned int tmpVal;
@@ -6458,6 +10430,9 @@ struct fann *fann_create_from_fd(FILE * conf, const char *configuration_file)
 		return NULL;
 	}
 
+	if(!read_connections)
+		return ann;
+
 	connected_neurons = ann->connections;
 	weights = ann->weights;
 	first_neuron = ann->first_layer->first_neuron;
@@ -6688,6 +10663,249 @@ fann_type fann_activation_derived(unsigned int activation_function,
 	return 0;
 }
 
+/* Maximum and minimum without a comparison, which would keep the compiler from vectorizing
+   the loops unless -fno-trapping-math is given */
+#define fann_max_approx(x, y) (0.5 * ((x) + (y) + fabs((x) - (y))))
+#define fann_min_approx(x, y) (0.5 * ((x) + (y) - fabs((x) - (y))))
+
+/* Adding and subtracting 1.5 * 2^52 rounds a double to the nearest integer, which is then
+   also found in the low bits of the mantissa of the sum */
+#define FANN_ROUND_MAGIC 6755399441055744.0
+
+/* INTERNAL FUNCTION
+   Approximation of exp with a relative error below 2e-7 for -708 <= x <= 708. Below that
+   it returns 0 instead of going through the denormals.
+
+   x = n * ln(2) + r with |r| <= ln(2) / 2, exp(r) is its Taylor polynomial of degree 6
+   and 2^n is built directly in the exponent bits. Only arithmetic and bit operations are
+   used, so loops calling it can be vectorized.
+ */
+fann_type fann_exp_approx(fann_type x)
+{
+	double t, n, r, p;
+	uint64_t bits;
+
+	/* only the lower bound is clamped, the sums of the neurons are never above 150 */
+	r = fann_max_approx((double) x, -746.0);
+	t = r * 1.44269504088896340736 + FANN_ROUND_MAGIC;
+	n = t - FANN_ROUND_MAGIC;
+	/* ln(2) split in two so that n * ln(2) is exact */
+	r = r - n * 6.93145751953125e-1 - n * 1.42860682030941723212e-6;
+	p = 1 + r * (1 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720))))));
+
+	/* the biased exponent of 2^n, 0 makes 2^n itself 0 when it would be a denormal */
+	t = fann_max_approx(n + 1023, 0.0) + FANN_ROUND_MAGIC;
+	memcpy(&bits, &t, sizeof(bits));
+	bits <<= 52;
+	memcpy(&t, &bits, sizeof(bits));
+	return (fann_type) (p * t);
+}
+
+/* INTERNAL FUNCTION
+   Approximation of sin with an absolute error below 1e-7.
+
+   x = k * pi + r with |r| <= pi / 2, sin(r) is its Taylor polynomial of degree 11 and
+   the sign is flipped when k is odd.
+ */
+fann_type fann_sin_approx(fann_type x)
+{
+	double t, k, r, r2, p;
+	uint64_t bits, sign;
+
+	t = (double) x * 0.31830988618379067154 + FANN_ROUND_MAGIC;
+	k = t - FANN_ROUND_MAGIC;
+	/* pi split in two so that k * pi is exact */
+	r = (double) x - k * 3.14159265358979311600 - k * 1.22464679914735317723e-16;
+	r2 = r * r;
+	p = r * (1 + r2 * (-1.0 / 6 + r2 * (1.0 / 120 + r2 * (-1.0 / 5040 + r2 * (1.0 / 362880 + r2 * (-1.0 / 39916800))))));
+
+	memcpy(&sign, &t, sizeof(sign));
+	sign <<= 63;
+	memcpy(&bits, &p, sizeof(bits));
+	bits ^= sign;
+	memcpy(&p, &bits, sizeof(bits));
+	return (fann_type) p;
+}
+
+#define fann_cos_approx(x) fann_sin_approx((x) + 1.57079632679489661923)
+
+/* INTERNAL FUNCTION
+   Sets the value of the neurons from first_neuron to last_neuron from their sum, with
+   FANN_APPROXIMATION_FAST. The loop of each activation function runs over the sums and
+   values of consecutive neurons using it, so it can be vectorized.
+ */
+void fann_activate_layer(struct fann *ann, struct fann_neuron *first_neuron, struct fann_neuron *last_neuron)
+{
+	struct fann_neuron *neuron_it, *run_end;
+	fann_type *sums = ann->sums + (first_neuron - ann->first_layer->first_neuron);
+	fann_type *values = ann->values + (first_neuron - ann->first_layer->first_neuron);
+	unsigned int i, n;
+	enum fann_activationfunc_enum activation_function;
+
+	neuron_it = first_neuron;
+	while(neuron_it != last_neuron)
+	{
+		if(neuron_it->first_con == neuron_it->last_con)
+		{
+			/* bias neurons */
+			*values++ = 1;
+			sums++;
+			neuron_it++;
+			continue;
+		}
+
+		activation_function = neuron_it->activation_function;
+		for(run_end = neuron_it;
+			run_end != last_neuron && run_end->activation_function == activation_function &&
+			run_end->first_con != run_end->last_con;
+			run_end++);
+		n = (unsigned int) (run_end - neuron_it);
+
+		switch (activation_function)
+		{
+			case FANN_SIGMOID:
+				for(i = 0; i != n; i++)
+					values[i] = 1 / (1 + fann_exp_approx(-2 * sums[i]));
+				break;
+			case FANN_SIGMOID_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					values[i] = 2 / (1 + fann_exp_approx(-2 * sums[i])) - 1;
+				break;
+			case FANN_GAUSSIAN:
+				for(i = 0; i != n; i++)
+					values[i] = fann_exp_approx(-sums[i] * sums[i]);
+				break;
+			case FANN_GAUSSIAN_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					values[i] = fann_exp_approx(-sums[i] * sums[i]) * 2 - 1;
+				break;
+			case FANN_ELLIOT:
+				for(i = 0; i != n; i++)
+					values[i] = fann_elliot_real(sums[i]);
+				break;
+			case FANN_ELLIOT_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					values[i] = fann_elliot_symmetric_real(sums[i]);
+				break;
+			case FANN_SIN_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					values[i] = fann_sin_approx(sums[i]);
+				break;
+			case FANN_COS_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					values[i] = fann_cos_approx(sums[i]);
+				break;
+			case FANN_SIN:
+				for(i = 0; i != n; i++)
+					values[i] = fann_sin_approx(sums[i]) / 2 + 0.5f;
+				break;
+			case FANN_COS:
+				for(i = 0; i != n; i++)
+					values[i] = fann_cos_approx(sums[i]) / 2 + 0.5f;
+				break;
+			default:
+				for(i = 0; i != n; i++)
+				{
+					fann_activation_switch(activation_function, sums[i], values[i]);
+				}
+				break;
+		}
+
+		neuron_it = run_end;
+		sums += n;
+		values += n;
+	}
+}
+
+/* INTERNAL FUNCTION
+   Multiplies the errors of the neurons from first_neuron to last_neuron by the derived of
+   their activation function, with FANN_APPROXIMATION_FAST. Gives the same results as
+   fann_activation_derived up to rounding, except for the approximation of sin and cos.
+ */
+void fann_activation_derived_layer(struct fann *ann, const struct fann_neuron *first_neuron,
+								   const struct fann_neuron *last_neuron, fann_type *errors)
+{
+	const struct fann_neuron *neuron_it, *run_end;
+	const fann_type *sums = ann->sums + (first_neuron - ann->first_layer->first_neuron);
+	const fann_type *values = ann->values + (first_neuron - ann->first_layer->first_neuron);
+	unsigned int i, n;
+	enum fann_activationfunc_enum activation_function;
+	fann_type steepness;
+
+	neuron_it = first_neuron;
+	while(neuron_it != last_neuron)
+	{
+		activation_function = neuron_it->activation_function;
+		steepness = neuron_it->activation_steepness;
+		for(run_end = neuron_it;
+			run_end != last_neuron && run_end->activation_function == activation_function &&
+			run_end->activation_steepness == steepness;
+			run_end++);
+		n = (unsigned int) (run_end - neuron_it);
+
+		switch (activation_function)
+		{
+			case FANN_LINEAR:
+			case FANN_LINEAR_PIECE:
+			case FANN_LINEAR_PIECE_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_linear_derive(steepness, values[i]);
+				break;
+			case FANN_SIGMOID:
+			case FANN_SIGMOID_STEPWISE:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_sigmoid_derive(steepness, fann_min_approx(fann_max_approx(values[i], 0.01f), 0.99f));
+				break;
+			case FANN_SIGMOID_SYMMETRIC:
+			case FANN_SIGMOID_SYMMETRIC_STEPWISE:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_sigmoid_symmetric_derive(steepness, fann_min_approx(fann_max_approx(values[i], -0.98f), 0.98f));
+				break;
+			case FANN_GAUSSIAN:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_gaussian_derive(steepness, values[i], sums[i]);
+				break;
+			case FANN_GAUSSIAN_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_gaussian_symmetric_derive(steepness, values[i], sums[i]);
+				break;
+			case FANN_ELLIOT:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_elliot_derive(steepness, values[i], sums[i]);
+				break;
+			case FANN_ELLIOT_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_elliot_symmetric_derive(steepness, values[i], sums[i]);
+				break;
+			case FANN_SIN_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					errors[i] *= steepness * fann_cos_approx(steepness * sums[i]);
+				break;
+			case FANN_COS_SYMMETRIC:
+				for(i = 0; i != n; i++)
+					errors[i] *= steepness * -fann_sin_approx(steepness * sums[i]);
+				break;
+			case FANN_SIN:
+				for(i = 0; i != n; i++)
+					errors[i] *= steepness * fann_cos_approx(steepness * sums[i]) / 2.0f;
+				break;
+			case FANN_COS:
+				for(i = 0; i != n; i++)
+					errors[i] *= steepness * -fann_sin_approx(steepness * sums[i]) / 2.0f;
+				break;
+			default:
+				for(i = 0; i != n; i++)
+					errors[i] *= fann_activation_derived(activation_function, steepness, values[i], sums[i]);
+				break;
+		}
+
+		neuron_it = run_end;
+		sums += n;
+		values += n;
+		errors += n;
+	}
+}
+
 /* INTERNAL FUNCTION
   Calculates the activation of a value, given an activation function
    and a steepness
@@ -6712,6 +10930,8 @@ FANN_EXTERNAL void FANN_API fann_train(struct fann *ann, fann_type * input,
 	fann_backpropagate_MSE(ann);
 
 	fann_update_weights(ann);
+
+	ann->precision_stale = 1;
 }
 #endif
 
@@ -6855,6 +11075,13 @@ void fann_compute_MSE(struct fann *ann, fann_type * desired_output)
 			return;
 		}
 	}
+	else if(ann->connection_rate >= 1 && ann->network_type == FANN_NETTYPE_LAYER)
+	{
+		/* only the hidden layers accumulate errors, the input layer never gets any and
+		 * the output layer is overwritten below */
+		memset(ann->train_errors + ((ann->first_layer + 1)->first_neuron - first_neuron), 0,
+			   (last_layer_begin - (ann->first_layer + 1)->first_neuron) * sizeof(fann_type));
+	}
 	else
 	{
 		/* clear the error variabels */
@@ -6870,7 +11097,7 @@ void fann_compute_MSE(struct fann *ann, fann_type * desired_output)
 
 	for(; last_layer_begin != last_layer_end; last_layer_begin++)
 	{
-		neuron_value = last_layer_begin->value;
+		neuron_value = ann->values[last_layer_begin - first_neuron];
 		neuron_diff = *desired_output - neuron_value;
 
 		neuron_diff = fann_update_MSE(ann, last_layer_begin, neuron_diff);
@@ -6885,15 +11112,25 @@ void fann_compute_MSE(struct fann *ann, fann_type * desired_output)
 				neuron_diff = (fann_type) log((1.0 + neuron_diff) / (1.0 - neuron_diff));
 		}
 
-		*error_it = fann_activation_derived(last_layer_begin->activation_function,
-											last_layer_begin->activation_steepness, neuron_value,
-											last_layer_begin->sum) * neuron_diff;
+		if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+			*error_it = fann_activation_derived(last_layer_begin->activation_function,
+												last_layer_begin->activation_steepness, neuron_value,
+												ann->sums[last_layer_begin - first_neuron]) * neuron_diff;
+		else
+			*error_it = neuron_diff;
 
 		desired_output++;
 		error_it++;
 
 		ann->num_MSE++;
 	}
+
+	if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+	{
+		last_layer_begin = (ann->last_layer - 1)->first_neuron;
+		fann_activation_derived_layer(ann, last_layer_begin, last_layer_end,
+									  error_begin + (last_layer_begin - first_neuron));
+	}
 }
 
 /* INTERNAL FUNCTION
@@ -6906,6 +11143,7 @@ void fann_backpropagate_MSE(struct fann *ann)
 {
 	fann_type tmp_error;
 	unsigned int i;
+	const unsigned int *active;
 	struct fann_layer *layer_it;
 	struct fann_neuron *neuron_it, *last_neuron;
 	struct fann_neuron **connections;
@@ -6940,12 +11178,15 @@ void fann_backpropagate_MSE(struct fann *ann)
 
 				tmp_error = error_begin[neuron_it - first_neuron];
 				weights = ann->weights + neuron_it->first_con;
-				for(i = neuron_it->last_con - neuron_it->first_con; i--;)
+				if(ann->active_offsets != NULL)
+				{
+					active = ann->active_first + (neuron_it - first_neuron);
+					fann_sparse_axpy(error_prev_layer, tmp_error, weights, ann->active_offsets + active[0],
+									 active[1] - active[0]);
+				}
+				else
 				{
-					/*printf("i = %d\n", i);
-					 * printf("error_prev_layer[%d] = %f\n", i, error_prev_layer[i]);
-					 * printf("weights[%d] = %f\n", i, weights[i]); */
-					error_prev_layer[i] += tmp_error * weights[i];
+					fann_axpy(error_prev_layer, tmp_error, weights, neuron_it->last_con - neuron_it->first_con);
 				}
 			}
 		}
@@ -6968,10 +11209,17 @@ void fann_backpropagate_MSE(struct fann *ann)
 		error_prev_layer = error_begin + ((layer_it - 1)->first_neuron - first_neuron);
 		last_neuron = (layer_it - 1)->last_neuron;
 
+		if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+		{
+			fann_activation_derived_layer(ann, (layer_it - 1)->first_neuron, last_neuron, error_prev_layer);
+			continue;
+		}
+
 		for(neuron_it = (layer_it - 1)->first_neuron; neuron_it != last_neuron; neuron_it++)
 		{
 			*error_prev_layer *= fann_activation_derived(neuron_it->activation_function,
-				neuron_it->activation_steepness, neuron_it->value, neuron_it->sum);
+				neuron_it->activation_steepness, ann->values[neuron_it - first_neuron],
+				ann->sums[neuron_it - first_neuron]);
 			error_prev_layer++;
 		}
 
@@ -6983,11 +11231,12 @@ void fann_backpropagate_MSE(struct fann *ann)
 */
 void fann_update_weights(struct fann *ann)
 {
-	struct fann_neuron *neuron_it, *last_neuron, *prev_neurons;
-	fann_type tmp_error, delta_w, *weights;
+	struct fann_neuron *neuron_it, *last_neuron;
+	fann_type tmp_error, delta_w, *weights, *prev_values;
 	struct fann_layer *layer_it;
 	unsigned int i;
 	unsigned int num_connections;
+	const unsigned int *active;
 
 	/* store some variabels local for fast access */
 	const float learning_rate = ann->learning_rate;
@@ -7014,7 +11263,7 @@ void fann_update_weights(struct fann *ann)
 	printf("\nupdate weights\n");
 #endif
 	deltas_begin = ann->prev_weights_deltas;
-	prev_neurons = first_neuron;
+	prev_values = ann->values;
 	for(layer_it = (first_layer + 1); layer_it != last_layer; layer_it++)
 	{
 #ifdef DEBUGTRAIN
@@ -7025,7 +11274,7 @@ void fann_update_weights(struct fann *ann)
 		{
 			if(ann->network_type == FANN_NETTYPE_LAYER)
 			{
-				prev_neurons = (layer_it - 1)->first_neuron;
+				prev_values = ann->values + ((layer_it - 1)->first_neuron - first_neuron);
 			}
 			for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
 			{
@@ -7033,11 +11282,21 @@ void fann_update_weights(struct fann *ann)
 				num_connections = neuron_it->last_con - neuron_it->first_con;
 				weights = ann->weights + neuron_it->first_con;
 				weights_deltas = deltas_begin + neuron_it->first_con;
-				for(i = 0; i != num_connections; i++)
+				if(ann->active_offsets != NULL)
 				{
-					delta_w = tmp_error * prev_neurons[i].value + learning_momentum * weights_deltas[i];
-					weights[i] += delta_w ;
-					weights_deltas[i] = delta_w;
+					active = ann->active_first + (neuron_it - first_neuron);
+					fann_sparse_momentum_step(weights, weights_deltas, tmp_error, prev_values, learning_momentum,
+											  ann->active_offsets + active[0], active[1] - active[0]);
+				}
+				else if(ann->connection_mask != NULL)
+				{
+					fann_masked_momentum_step(weights, weights_deltas, tmp_error, prev_values, learning_momentum,
+											  ann->connection_mask + neuron_it->first_con, num_connections);
+				}
+				else
+				{
+					fann_momentum_step(weights, weights_deltas, tmp_error, prev_values, learning_momentum,
+									   num_connections);
 				}
 			}
 		}
@@ -7051,7 +11310,9 @@ void fann_update_weights(struct fann *ann)
 				weights_deltas = deltas_begin + neuron_it->first_con;
 				for(i = 0; i != num_connections; i++)
 				{
-					delta_w = tmp_error * prev_neurons[i].value + learning_momentum * weights_deltas[i];
+					delta_w = tmp_error * prev_values[i] + learning_momentum * weights_deltas[i];
+					if(ann->connection_mask != NULL)
+						delta_w *= ann->connection_mask[neuron_it->first_con + i];
 					weights[i] += delta_w;
 					weights_deltas[i] = delta_w;
 				}
@@ -7069,9 +11330,10 @@ void fann_update_weights(struct fann *ann)
 void fann_update_slopes_batch(struct fann *ann, struct fann_layer *layer_begin,
 							  struct fann_layer *layer_end)
 {
-	struct fann_neuron *neuron_it, *last_neuron, *prev_neurons, **connections;
-	fann_type tmp_error;
+	struct fann_neuron *neuron_it, *last_neuron, **connections;
+	fann_type tmp_error, *prev_values;
 	unsigned int i, num_connections;
+	const unsigned int *active;
 
 	/* store some variabels local for fast access */
 	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
@@ -7106,7 +11368,7 @@ void fann_update_slopes_batch(struct fann *ann, struct fann_layer *layer_begin,
 	printf("\nupdate slopes\n");
 #endif
 
-	prev_neurons = first_neuron;
+	prev_values = ann->values;
 
 	for(; layer_begin <= layer_end; layer_begin++)
 	{
@@ -7118,7 +11380,7 @@ void fann_update_slopes_batch(struct fann *ann, struct fann_layer *layer_begin,
 		{
 			if(ann->network_type == FANN_NETTYPE_LAYER)
 			{
-				prev_neurons = (layer_begin - 1)->first_neuron;
+				prev_values = ann->values + ((layer_begin - 1)->first_neuron - first_neuron);
 			}
 
 			for(neuron_it = layer_begin->first_neuron; neuron_it != last_neuron; neuron_it++)
@@ -7126,9 +11388,15 @@ void fann_update_slopes_batch(struct fann *ann, struct fann_layer *layer_begin,
 				tmp_error = error_begin[neuron_it - first_neuron];
 				neuron_slope = slope_begin + neuron_it->first_con;
 				num_connections = neuron_it->last_con - neuron_it->first_con;
-				for(i = 0; i != num_connections; i++)
+				if(ann->active_offsets != NULL)
+				{
+					active = ann->active_first + (neuron_it - first_neuron);
+					fann_sparse_axpy(neuron_slope, tmp_error, prev_values, ann->active_offsets + active[0],
+									 active[1] - active[0]);
+				}
+				else
 				{
-					neuron_slope[i] += tmp_error * prev_neurons[i].value;
+					fann_axpy(neuron_slope, tmp_error, prev_values, num_connections);
 				}
 			}
 		}
@@ -7142,7 +11410,7 @@ void fann_update_slopes_batch(struct fann *ann, struct fann_layer *layer_begin,
 				connections = ann->connections + neuron_it->first_con;
 				for(i = 0; i != num_connections; i++)
 				{
-					neuron_slope[i] += tmp_error * connections[i]->value;
+					neuron_slope[i] += tmp_error * ann->values[connections[i] - first_neuron];
 				}
 			}
 		}
@@ -7213,6 +11481,8 @@ void fann_clear_train_arrays(struct fann *ann)
 	{
 		memset(ann->prev_train_slopes, 0, (ann->total_connections_allocated) * sizeof(fann_type));
 	}
+
+	ann->adam_timestep = 0;
 }
 
 /* INTERNAL FUNCTION
@@ -7231,6 +11501,8 @@ void fann_update_weights_batch(struct fann *ann, unsigned int num_data, unsigned
 		weights[i] += train_slopes[i] * epsilon;
 		train_slopes[i] = 0.0;
 	}
+
+	fann_apply_connection_mask(ann, first_weight, past_end);
 }
 
 /* INTERNAL FUNCTION
@@ -7319,6 +11591,8 @@ void fann_update_weights_quickprop(struct fann *ann, unsigned int num_data,
 		prev_train_slopes[i] = slope;
 		train_slopes[i] = 0.0;
 	}
+
+	fann_apply_connection_mask(ann, first_weight, past_end);
 }
 
 /* INTERNAL FUNCTION
@@ -7378,6 +11652,8 @@ void fann_update_weights_irpropm(struct fann *ann, unsigned int first_weight, un
 		prev_train_slopes[i] = slope;
 		train_slopes[i] = 0.0;
 	}
+
+	fann_apply_connection_mask(ann, first_weight, past_end);
 }
 
 /* INTERNAL FUNCTION
@@ -7457,11 +11733,86 @@ void fann_update_weights_sarprop(struct fann *ann, unsigned int epoch, unsigned
 		prev_train_slopes[i] = slope;
 		train_slopes[i] = 0.0;
 	}
+
+	fann_apply_connection_mask(ann, first_weight, past_end);
+}
+
+/* INTERNAL FUNCTION
+   The Adam training algorithm, AdamW when adam_weight_decay is above 0.
+
+   The running means of the slopes and of the squared slopes are kept in prev_train_slopes
+   and prev_steps, which the other batch algorithms use for their own state. The slopes are
+   the mean over the num_data patterns since the last update, and every weight is updated
+   in one pass, with the bias corrections folded into two constants.
+ */
+void fann_update_weights_adam(struct fann *ann, unsigned int num_data, unsigned int first_weight,
+							  unsigned int past_end)
+{
+	fann_type *train_slopes = ann->train_slopes + first_weight;
+	fann_type *weights = ann->weights + first_weight;
+	fann_type *means = ann->prev_train_slopes + first_weight;
+	fann_type *squares = ann->prev_steps + first_weight;
+	const fann_type *lanes_end = weights + ((past_end - first_weight) & ~7u);
+	const fann_type *weights_end = weights + (past_end - first_weight);
+	fann_type slope, mean, square, roots[8], mean_lanes[8], square_lanes[8];
+	unsigned int j;
+
+	const fann_type beta1 = ann->adam_beta1;
+	const fann_type beta2 = ann->adam_beta2;
+	const fann_type epsilon = ann->adam_epsilon;
+	const fann_type slope_scale = (fann_type) 1.0 / num_data;
+	const fann_type decay = 1 - ann->learning_rate * ann->adam_weight_decay;
+	fann_type step, square_scale;
+
+	ann->adam_timestep++;
+	step = ann->learning_rate / (1 - pow(beta1, ann->adam_timestep));
+	square_scale = 1 / (1 - pow(beta2, ann->adam_timestep));
+
+	/* eight weights at a time, so the square roots can use vector instructions */
+	for(; weights != lanes_end; weights += 8, means += 8, squares += 8, train_slopes += 8)
+	{
+		/* everything is loaded before anything is stored, like in fann_axpy */
+		for(j = 0; j != 8; j++)
+		{
+			slope = train_slopes[j] * slope_scale;
+			mean_lanes[j] = beta1 * means[j] + (1 - beta1) * slope;
+			square_lanes[j] = beta2 * squares[j] + (1 - beta2) * slope * slope;
+			roots[j] = square_lanes[j] * square_scale;
+		}
+		fann_sqrt8(roots);
+		for(j = 0; j != 8; j++)
+		{
+			roots[j] = weights[j] * decay + step * mean_lanes[j] / (roots[j] + epsilon);
+		}
+		for(j = 0; j != 8; j++)
+		{
+			weights[j] = roots[j];
+			means[j] = mean_lanes[j];
+			squares[j] = square_lanes[j];
+			train_slopes[j] = 0.0;
+		}
+	}
+
+	for(; weights != weights_end; weights++, means++, squares++, train_slopes++)
+	{
+		slope = *train_slopes * slope_scale;
+		mean = beta1 * *means + (1 - beta1) * slope;
+		square = beta2 * *squares + (1 - beta2) * slope * slope;
+		*weights = *weights * decay + step * mean / (sqrt(square * square_scale) + epsilon);
+		*means = mean;
+		*squares = square;
+		*train_slopes = 0.0;
+	}
+
+	fann_apply_connection_mask(ann, first_weight, past_end);
 }
 
 #endif
 
 FANN_GET_SET(enum fann_train_enum, training_algorithm)
+FANN_GET_SET(enum fann_approximation_enum, activation_approximation)
+FANN_GET_SET(unsigned int, num_threads)
+FANN_GET_SET(unsigned int, batch_size)
 FANN_GET_SET(float, learning_rate)
 
 FANN_EXTERNAL void FANN_API fann_set_activation_function_hidden(struct fann *ann,
@@ -7656,6 +12007,10 @@ FANN_GET_SET(float, sarprop_weight_decay_shift)
 FANN_GET_SET(float, sarprop_step_error_threshold_factor)
 FANN_GET_SET(float, sarprop_step_error_shift)
 FANN_GET_SET(float, sarprop_temperature)
+FANN_GET_SET(float, adam_beta1)
+FANN_GET_SET(float, adam_beta2)
+FANN_GET_SET(float, adam_epsilon)
+FANN_GET_SET(float, adam_weight_decay)
 FANN_GET_SET(enum fann_stopfunc_enum, train_stop_function)
 FANN_GET_SET(fann_type, bit_fail_limit)
 FANN_GET_SET(float, learning_momentum)
@@ -7673,79 +12028,693 @@ FANN_EXTERNAL struct fann_train_data *FANN_API fann_read_train_from_file(const c
 	struct fann_train_data *data;
 	FILE *file = fopen(configuration_file, "r");
 
-	if(!file)
+	if(!file)
+	{
+		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
+		return NULL;
+	}
+
+	data = fann_read_train_from_fd(file, configuration_file);
+	fclose(file);
+	return data;
+}
+
+/*
+ * Save training data to a file
+ */
+FANN_EXTERNAL int FANN_API fann_save_train(struct fann_train_data *data, const char *filename)
+{
+	return fann_save_train_internal(data, filename, 0, 0);
+}
+
+/*
+ * Save training data to a file in fixed point algebra. (Good for testing
+ * a network in fixed point)
+ */
+FANN_EXTERNAL int FANN_API fann_save_train_to_fixed(struct fann_train_data *data, const char *filename,
+													 unsigned int decimal_point)
+{
+	return fann_save_train_internal(data, filename, 1, decimal_point);
+}
+
+/*
+ * deallocate the train data structure.
+ */
+FANN_EXTERNAL void FANN_API fann_destroy_train(struct fann_train_data *data)
+{
+	if(data == NULL)
+		return;
+	if(data->input != NULL)
+		fann_safe_free(data->input[0]);
+	if(data->output != NULL)
+		fann_safe_free(data->output[0]);
+	fann_safe_free(data->input);
+	fann_safe_free(data->output);
+	fann_safe_free(data);
+}
+
+/*
+ * Test a set of training data and calculate the MSE
+ */
+FANN_EXTERNAL float FANN_API fann_test_data(struct fann *ann, struct fann_train_data *data)
+{
+	unsigned int i;
+	if(fann_check_input_output_sizes(ann, data) == -1)
+		return 0;
+
+	fann_reset_MSE(ann);
+
+	for(i = 0; i != data->num_data; i++)
+	{
+		fann_test(ann, data->input[i], data->output[i]);
+	}
+
+	return fann_get_MSE(ann);
+}
+
+#ifndef FIXEDFANN
+
+FANN_EXTERNAL struct fann_sum_cache *FANN_API fann_create_sum_cache(struct fann *ann,
+																	struct fann_train_data *data)
+{
+	struct fann_sum_cache *cache;
+	struct fann_layer *layer_it = ann->first_layer + 1;
+
+	if(fann_check_input_output_sizes(ann, data) == -1)
+		return NULL;
+
+	cache = (struct fann_sum_cache *) malloc(sizeof(struct fann_sum_cache));
+	if(cache == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		return NULL;
+	}
+	cache->data = data;
+	cache->first_neuron = (unsigned int) (layer_it->first_neuron - ann->first_layer->first_neuron);
+	cache->num_neurons = (unsigned int) (layer_it->last_neuron - layer_it->first_neuron);
+	cache->first_con = layer_it->first_neuron->first_con;
+	cache->num_connections = (layer_it->last_neuron - 1)->last_con - cache->first_con;
+	cache->sums = (fann_type *) calloc((size_t) data->num_data * cache->num_neurons, sizeof(fann_type));
+	cache->weights = (fann_type *) malloc(cache->num_connections * sizeof(fann_type));
+	if(cache->sums == NULL || cache->weights == NULL)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+		fann_destroy_sum_cache(cache);
+		return NULL;
+	}
+
+	fann_compute_cached_sums(ann, cache);
+	return cache;
+}
+
+/* INTERNAL FUNCTION
+   Computes the sums of cache from scratch with the current weights of ann, and copies
+   the weights into the cache.
+ */
+void fann_compute_cached_sums(struct fann *ann, struct fann_sum_cache *cache)
+{
+	struct fann_layer *layer_it = ann->first_layer + 1;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	unsigned int num_input = ann->num_input;
+	int pattern;
+
+	memcpy(cache->weights, ann->weights + cache->first_con, cache->num_connections * sizeof(fann_type));
+
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	int num_threads = ann->num_threads != 0 ? (int) ann->num_threads : omp_get_max_threads();
+	#pragma omp parallel for num_threads(num_threads) schedule(static)
+#endif
+	for(pattern = 0; pattern < (int) cache->data->num_data; pattern++)
+	{
+		const fann_type *input = cache->data->input[pattern];
+		fann_type *sums = cache->sums + (size_t) pattern * cache->num_neurons;
+		struct fann_neuron *neuron_it;
+		const fann_type *weights;
+		unsigned int i;
+
+		for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++, sums++)
+		{
+			if(neuron_it->first_con == neuron_it->last_con)
+				continue;
+
+			weights = ann->weights + neuron_it->first_con;
+			if(ann->connection_rate >= 1)
+			{
+				/* the last connection is from the bias neuron of the input layer */
+				*sums = fann_dot(weights, input, num_input) + weights[num_input];
+			}
+			else
+			{
+				*sums = 0;
+				for(i = neuron_it->first_con; i != neuron_it->last_con; i++)
+				{
+					if((unsigned int) (ann->connections[i] - first_neuron) == num_input)
+						*sums += ann->weights[i];
+					else
+						*sums += ann->weights[i] * input[ann->connections[i] - first_neuron];
+				}
+			}
+		}
+	}
+}
+
+FANN_EXTERNAL unsigned int FANN_API fann_update_sum_cache(struct fann *ann, struct fann_sum_cache *cache)
+{
+	struct fann_layer *layer_it = ann->first_layer + 1;
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	struct fann_neuron *neuron_it;
+	const fann_type *weights = ann->weights + cache->first_con;
+	unsigned int *changed_neurons, *changed_inputs;
+	fann_type *changed_deltas;
+	unsigned int i, con, change, num_changed = 0, num_weights_changed, past_changed;
+	unsigned int max_changed = cache->num_connections / 2;
+	int pattern;
+
+	for(i = 0; i != cache->num_connections; i++)
+	{
+		if(weights[i] != cache->weights[i])
+			num_changed++;
+	}
+	if(num_changed == 0)
+		return 0;
+
+	changed_neurons = NULL;
+	changed_inputs = NULL;
+	changed_deltas = NULL;
+	if(num_changed <= max_changed)
+	{
+		changed_neurons = (unsigned int *) malloc(num_changed * sizeof(unsigned int));
+		changed_inputs = (unsigned int *) malloc(num_changed * sizeof(unsigned int));
+		changed_deltas = (fann_type *) malloc(num_changed * sizeof(fann_type));
+	}
+	if(changed_neurons == NULL || changed_inputs == NULL || changed_deltas == NULL)
+	{
+		/* too many changes to be worth it, or no memory for them */
+		fann_safe_free(changed_neurons);
+		fann_safe_free(changed_inputs);
+		fann_safe_free(changed_deltas);
+		fann_compute_cached_sums(ann, cache);
+		return num_changed;
+	}
+
+	/* the connections from the bias neuron, whose input is 1, go at the end of the list */
+	num_weights_changed = 0;
+	past_changed = num_changed;
+	for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron; neuron_it++)
+	{
+		for(con = neuron_it->first_con; con != neuron_it->last_con; con++)
+		{
+			i = con - cache->first_con;
+			if(weights[i] == cache->weights[i])
+				continue;
+			if((unsigned int) (ann->connections[con] - first_neuron) == ann->num_input)
+				change = --past_changed;
+			else
+				change = num_weights_changed++;
+			changed_neurons[change] = (unsigned int) (neuron_it - layer_it->first_neuron);
+			changed_inputs[change] = (unsigned int) (ann->connections[con] - first_neuron);
+			changed_deltas[change] = weights[i] - cache->weights[i];
+			cache->weights[i] = weights[i];
+		}
+	}
+
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	int num_threads = ann->num_threads != 0 ? (int) ann->num_threads : omp_get_max_threads();
+	#pragma omp parallel for num_threads(num_threads) schedule(static) private(i)
+#endif
+	for(pattern = 0; pattern < (int) cache->data->num_data; pattern++)
+	{
+		const fann_type *input = cache->data->input[pattern];
+		fann_type *sums = cache->sums + (size_t) pattern * cache->num_neurons;
+
+		for(i = 0; i != num_weights_changed; i++)
+		{
+			sums[changed_neurons[i]] += changed_deltas[i] * input[changed_inputs[i]];
+		}
+		for(; i != num_changed; i++)
+		{
+			sums[changed_neurons[i]] += changed_deltas[i];
+		}
+	}
+
+	fann_safe_free(changed_neurons);
+	fann_safe_free(changed_inputs);
+	fann_safe_free(changed_deltas);
+	return num_changed;
+}
+
+FANN_EXTERNAL fann_type *FANN_API fann_run_sum_cache(struct fann *ann, struct fann_sum_cache *cache,
+													 unsigned int pattern)
+{
+	struct fann_layer *layer_it = ann->first_layer + 1;
+	struct fann_neuron *neuron_it;
+	const fann_type *input;
+	const fann_type *cached_sums;
+	fann_type *values = ann->values;
+	fann_type *sums;
+	fann_type neuron_sum, steepness, max_sum;
+	unsigned int i;
+
+	if(pattern >= cache->data->num_data)
+	{
+		fann_error((struct fann_error *) ann, FANN_E_INDEX_OUT_OF_BOUND, pattern);
+		return NULL;
+	}
+
+	/* only the later layers of shortcut networks are connected to the inputs */
+	if(ann->network_type == FANN_NETTYPE_SHORTCUT)
+	{
+		input = cache->data->input[pattern];
+		for(i = 0; i != ann->num_input; i++)
+		{
+			values[i] = input[i];
+		}
+		values[ann->num_input] = 1;
+	}
+
+	cached_sums = cache->sums + (size_t) pattern * cache->num_neurons;
+	values += cache->first_neuron;
+	sums = ann->sums + cache->first_neuron;
+	for(neuron_it = layer_it->first_neuron; neuron_it != layer_it->last_neuron;
+		neuron_it++, cached_sums++, values++, sums++)
+	{
+		if(neuron_it->first_con == neuron_it->last_con)
+		{
+			/* bias neurons */
+			*values = 1;
+			continue;
+		}
+
+		steepness = neuron_it->activation_steepness;
+		neuron_sum = fann_mult(steepness, *cached_sums);
+		max_sum = 150/steepness;
+		if(neuron_sum > max_sum)
+			neuron_sum = max_sum;
+		else if(neuron_sum < -max_sum)
+			neuron_sum = -max_sum;
+
+		*sums = neuron_sum;
+
+		if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+			fann_activation_switch(neuron_it->activation_function, neuron_sum, *values);
+	}
+	if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+		fann_activate_layer(ann, layer_it->first_neuron, layer_it->last_neuron);
+
+	fann_run_layers(ann, layer_it + 1);
+	return ann->output;
+}
+
+FANN_EXTERNAL void FANN_API fann_destroy_sum_cache(struct fann_sum_cache *cache)
+{
+	if(cache == NULL)
+		return;
+	fann_safe_free(cache->sums);
+	fann_safe_free(cache->weights);
+	fann_safe_free(cache);
+}
+
+#endif	/* NOT FIXEDFANN */
+
+#ifndef FIXEDFANN
+
+/* INTERNAL FUNCTION
+   Runs every pattern of data through the network, backpropagates its error and adds
+   its slopes to train_slopes, as the batch training algorithms do before updating
+   the weights.
+
+   When the library is compiled with OpenMP the patterns are split in one contiguous
+   chunk per thread. The first chunk is computed on ann itself and the others on its
+   parallel_workers, whose slopes and MSE are then added to those of ann in chunk order.
+ */
+void fann_compute_epoch_slopes(struct fann *ann, struct fann_train_data *data)
+{
+	unsigned int i;
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	int thread, num_weights;
+	unsigned int num_threads = ann->num_threads;
+	fann_type *slopes;
+	struct fann *worker;
+
+	if(num_threads == 0)
+		num_threads = (unsigned int) omp_get_max_threads();
+	if(num_threads > data->num_data)
+		num_threads = data->num_data;
+
+	if(num_threads > 1 && ann->precision == FANN_PRECISION_DEFAULT &&
+	   fann_prepare_parallel_workers(ann, num_threads - 1) == 0)
+	{
+		#pragma omp parallel for num_threads(num_threads) schedule(static, 1) private(i, worker)
+		for(thread = 0; thread < (int) num_threads; thread++)
+		{
+			unsigned int first_data = (unsigned int) ((unsigned long) data->num_data * thread / num_threads);
+			unsigned int past_data = (unsigned int) ((unsigned long) data->num_data * (thread + 1) / num_threads);
+
+			worker = thread == 0 ? ann : ann->parallel_workers + (thread - 1);
+			for(i = first_data; i < past_data; i++)
+			{
+				fann_run(worker, data->input[i]);
+				fann_compute_MSE(worker, data->output[i]);
+				fann_backpropagate_MSE(worker);
+				fann_update_slopes_batch(worker, worker->first_layer + 1, worker->last_layer - 1);
+			}
+		}
+
+		if(ann->train_slopes == NULL)
+			return;
+
+		/* Each slope is summed in chunk order, whichever thread sums it */
+		num_weights = (int) ann->total_connections;
+		slopes = ann->train_slopes;
+		#pragma omp parallel for num_threads(num_threads) schedule(static) private(i)
+		for(thread = 0; thread < num_weights; thread++)
+		{
+			for(i = 0; i < num_threads - 1; i++)
+			{
+				slopes[thread] += ann->parallel_workers[i].train_slopes[thread];
+				ann->parallel_workers[i].train_slopes[thread] = 0;
+			}
+		}
+
+		for(i = 0; i < num_threads - 1; i++)
+		{
+			worker = ann->parallel_workers + i;
+			ann->MSE_value += worker->MSE_value;
+			ann->num_MSE += worker->num_MSE;
+			ann->num_bit_fail += worker->num_bit_fail;
+		}
+		return;
+	}
+#endif
+
+	for(i = 0; i < data->num_data; i++)
+	{
+		fann_run(ann, data->input[i]);
+		fann_compute_MSE(ann, data->output[i]);
+		fann_backpropagate_MSE(ann);
+		fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
+	}
+}
+
+/* INTERNAL FUNCTION
+   Makes sure ann has num_workers parallel_workers and copies the current state of
+   ann into them, keeping their own buffers. The buffers are reallocated when the
+   number of workers or the size of the network changed.
+ */
+int fann_prepare_parallel_workers(struct fann *ann, unsigned int num_workers)
+{
+	unsigned int i;
+	struct fann *worker;
+	fann_type *values, *sums, *output, *train_errors, *train_slopes;
+
+	if(ann->num_parallel_workers != num_workers ||
+	   ann->parallel_workers[0].total_neurons_allocated != ann->total_neurons_allocated ||
+	   ann->parallel_workers[0].total_connections_allocated != ann->total_connections_allocated)
+	{
+		fann_destroy_parallel_workers(ann);
+
+		ann->parallel_workers = (struct fann *) calloc(num_workers, sizeof(struct fann));
+		if(ann->parallel_workers == NULL)
+		{
+			fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+			return -1;
+		}
+		ann->num_parallel_workers = num_workers;
+
+		for(i = 0; i != num_workers; i++)
+		{
+			worker = ann->parallel_workers + i;
+			worker->total_neurons_allocated = ann->total_neurons_allocated;
+			worker->total_connections_allocated = ann->total_connections_allocated;
+			worker->values = (fann_type *) calloc(ann->total_neurons_allocated, sizeof(fann_type));
+			worker->sums = (fann_type *) calloc(ann->total_neurons_allocated, sizeof(fann_type));
+			worker->output = (fann_type *) calloc(ann->num_output, sizeof(fann_type));
+			worker->train_errors = (fann_type *) calloc(ann->total_neurons_allocated, sizeof(fann_type));
+			worker->train_slopes = (fann_type *) calloc(ann->total_connections_allocated, sizeof(fann_type));
+			if(worker->values == NULL || worker->sums == NULL || worker->output == NULL ||
+			   worker->train_errors == NULL || worker->train_slopes == NULL)
+			{
+				fann_destroy_parallel_workers(ann);
+				fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+				return -1;
+			}
+		}
+	}
+
+	for(i = 0; i != num_workers; i++)
 	{
-		fann_error(NULL, FANN_E_CANT_OPEN_CONFIG_R, configuration_file);
-		return NULL;
+		worker = ann->parallel_workers + i;
+		values = worker->values;
+		sums = worker->sums;
+		output = worker->output;
+		train_errors = worker->train_errors;
+		train_slopes = worker->train_slopes;
+
+		*worker = *ann;
+
+		worker->values = values;
+		worker->sums = sums;
+		worker->output = output;
+		worker->train_errors = train_errors;
+		worker->train_slopes = train_slopes;
+		worker->errstr = NULL;
+		worker->parallel_workers = NULL;
+		worker->num_parallel_workers = 0;
+		worker->batch_values = NULL;
+		worker->batch_sums = NULL;
+		worker->batch_errors = NULL;
+		worker->batch_buffer_size = 0;
+		fann_reset_MSE(worker);
 	}
 
-	data = fann_read_train_from_fd(file, configuration_file);
-	fclose(file);
-	return data;
+	return 0;
 }
 
-/*
- * Save training data to a file
+/* INTERNAL FUNCTION
+   Frees the parallel_workers of ann.
  */
-FANN_EXTERNAL int FANN_API fann_save_train(struct fann_train_data *data, const char *filename)
+void fann_destroy_parallel_workers(struct fann *ann)
 {
-	return fann_save_train_internal(data, filename, 0, 0);
-}
+	unsigned int i;
 
-/*
- * Save training data to a file in fixed point algebra. (Good for testing
- * a network in fixed point)
- */
-FANN_EXTERNAL int FANN_API fann_save_train_to_fixed(struct fann_train_data *data, const char *filename,
-													 unsigned int decimal_point)
-{
-	return fann_save_train_internal(data, filename, 1, decimal_point);
+	if(ann->parallel_workers == NULL)
+		return;
+
+	for(i = 0; i != ann->num_parallel_workers; i++)
+	{
+		fann_safe_free(ann->parallel_workers[i].values);
+		fann_safe_free(ann->parallel_workers[i].sums);
+		fann_safe_free(ann->parallel_workers[i].output);
+		fann_safe_free(ann->parallel_workers[i].train_errors);
+		fann_safe_free(ann->parallel_workers[i].train_slopes);
+		fann_safe_free(ann->parallel_workers[i].errstr);
+	}
+	fann_safe_free(ann->parallel_workers);
+	ann->num_parallel_workers = 0;
 }
 
-/*
- * deallocate the train data structure.
+/* INTERNAL FUNCTION
+   Adds the slopes of the patterns first_data to first_data + num_data - 1 of data to
+   train_slopes and their errors to the MSE, with the same result as running fann_run,
+   fann_compute_MSE, fann_backpropagate_MSE and fann_update_slopes_batch on each of them.
+
+   For fully connected layered networks the patterns are computed a layer at a time in
+   batch_values, batch_sums and batch_errors: each neuron goes through all the patterns
+   before the next one, so its weights and slopes are read from memory once per batch.
+   The activation and error helpers work on ann->values, ann->sums and ann->train_errors,
+   so those are pointed at each pattern in turn and restored at the end.
  */
-FANN_EXTERNAL void FANN_API fann_destroy_train(struct fann_train_data *data)
+void fann_compute_batch_slopes(struct fann *ann, struct fann_train_data *data,
+							   unsigned int first_data, unsigned int num_data)
 {
-	if(data == NULL)
+	struct fann_neuron *neuron_it, *last_neuron;
+	struct fann_layer *layer_it;
+	unsigned int i, b, num_connections, neuron_index, prev_index;
+	fann_type neuron_sum, max_sum, steepness, tmp_error;
+	fann_type *weights, *slopes, *values, *errors;
+
+	struct fann_neuron *first_neuron = ann->first_layer->first_neuron;
+	struct fann_layer *first_layer = ann->first_layer;
+	struct fann_layer *last_layer = ann->last_layer;
+	const unsigned int total_neurons = ann->total_neurons;
+	const unsigned int num_input = ann->num_input;
+	fann_type *saved_values = ann->values;
+	fann_type *saved_sums = ann->sums;
+	fann_type *saved_errors = ann->train_errors;
+
+	if(ann->connection_rate < 1 || ann->network_type != FANN_NETTYPE_LAYER ||
+	   ann->precision != FANN_PRECISION_DEFAULT || ann->active_offsets != NULL)
+	{
+		for(i = first_data; i != first_data + num_data; i++)
+		{
+			fann_run(ann, data->input[i]);
+			fann_compute_MSE(ann, data->output[i]);
+			fann_backpropagate_MSE(ann);
+			fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
+		}
 		return;
-	if(data->input != NULL)
-		fann_safe_free(data->input[0]);
-	if(data->output != NULL)
-		fann_safe_free(data->output[0]);
-	fann_safe_free(data->input);
-	fann_safe_free(data->output);
-	fann_safe_free(data);
-}
+	}
 
-/*
- * Test a set of training data and calculate the MSE
- */
-FANN_EXTERNAL float FANN_API fann_test_data(struct fann *ann, struct fann_train_data *data)
-{
-	unsigned int i;
-	if(fann_check_input_output_sizes(ann, data) == -1)
-		return 0;
+	if(ann->train_slopes == NULL)
+	{
+		ann->train_slopes =
+			(fann_type *) calloc(ann->total_connections_allocated, sizeof(fann_type));
+		if(ann->train_slopes == NULL)
+		{
+			fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+			return;
+		}
+	}
 
-	fann_reset_MSE(ann);
+	if(ann->batch_buffer_size < num_data * total_neurons)
+	{
+		fann_safe_free(ann->batch_values);
+		fann_safe_free(ann->batch_sums);
+		fann_safe_free(ann->batch_errors);
+		ann->batch_buffer_size = 0;
+		ann->batch_values = (fann_type *) calloc(num_data * total_neurons, sizeof(fann_type));
+		ann->batch_sums = (fann_type *) calloc(num_data * total_neurons, sizeof(fann_type));
+		ann->batch_errors = (fann_type *) calloc(num_data * total_neurons, sizeof(fann_type));
+		if(ann->batch_values == NULL || ann->batch_sums == NULL || ann->batch_errors == NULL)
+		{
+			fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+			return;
+		}
+		ann->batch_buffer_size = num_data * total_neurons;
+	}
 
-	for(i = 0; i != data->num_data; i++)
+	/* forward pass */
+	for(b = 0; b != num_data; b++)
 	{
-		fann_test(ann, data->input[i], data->output[i]);
+		values = ann->batch_values + b * total_neurons;
+		memcpy(values, data->input[first_data + b], num_input * sizeof(fann_type));
+		values[num_input] = 1;
 	}
 
-	return fann_get_MSE(ann);
-}
+	for(layer_it = first_layer + 1; layer_it != last_layer; layer_it++)
+	{
+		last_neuron = layer_it->last_neuron;
+		prev_index = (unsigned int) ((layer_it - 1)->first_neuron - first_neuron);
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			neuron_index = (unsigned int) (neuron_it - first_neuron);
+			if(neuron_it->first_con == neuron_it->last_con)
+			{
+				/* bias neurons */
+				for(b = 0; b != num_data; b++)
+					ann->batch_values[b * total_neurons + neuron_index] = 1;
+				continue;
+			}
 
-#ifndef FIXEDFANN
+			steepness = neuron_it->activation_steepness;
+			max_sum = 150 / steepness;
+			num_connections = neuron_it->last_con - neuron_it->first_con;
+			weights = ann->weights + neuron_it->first_con;
+
+			for(b = 0; b != num_data; b++)
+			{
+				values = ann->batch_values + b * total_neurons;
+				neuron_sum = steepness * fann_dot(weights, values + prev_index, num_connections);
+				if(neuron_sum > max_sum)
+					neuron_sum = max_sum;
+				else if(neuron_sum < -max_sum)
+					neuron_sum = -max_sum;
+
+				ann->batch_sums[b * total_neurons + neuron_index] = neuron_sum;
+				if(ann->activation_approximation == FANN_APPROXIMATION_NONE)
+					fann_activation_switch(neuron_it->activation_function, neuron_sum, values[neuron_index]);
+			}
+		}
+
+		if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+		{
+			for(b = 0; b != num_data; b++)
+			{
+				ann->values = ann->batch_values + b * total_neurons;
+				ann->sums = ann->batch_sums + b * total_neurons;
+				fann_activate_layer(ann, layer_it->first_neuron, last_neuron);
+			}
+		}
+	}
+
+	/* errors of the output layer */
+	for(b = 0; b != num_data; b++)
+	{
+		ann->values = ann->batch_values + b * total_neurons;
+		ann->sums = ann->batch_sums + b * total_neurons;
+		ann->train_errors = ann->batch_errors + b * total_neurons;
+		fann_compute_MSE(ann, data->output[first_data + b]);
+	}
+
+	/* backward pass, from the last hidden layer to the first one */
+	for(layer_it = last_layer - 1; layer_it > first_layer + 1; --layer_it)
+	{
+		last_neuron = layer_it->last_neuron;
+		prev_index = (unsigned int) ((layer_it - 1)->first_neuron - first_neuron);
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			neuron_index = (unsigned int) (neuron_it - first_neuron);
+			num_connections = neuron_it->last_con - neuron_it->first_con;
+			weights = ann->weights + neuron_it->first_con;
+			for(b = 0; b != num_data; b++)
+			{
+				errors = ann->batch_errors + b * total_neurons;
+				fann_axpy(errors + prev_index, errors[neuron_index], weights, num_connections);
+			}
+		}
+
+		last_neuron = (layer_it - 1)->last_neuron;
+		for(b = 0; b != num_data; b++)
+		{
+			ann->values = ann->batch_values + b * total_neurons;
+			ann->sums = ann->batch_sums + b * total_neurons;
+			errors = ann->batch_errors + b * total_neurons;
+			if(ann->activation_approximation == FANN_APPROXIMATION_FAST)
+			{
+				fann_activation_derived_layer(ann, (layer_it - 1)->first_neuron, last_neuron,
+											  errors + prev_index);
+				continue;
+			}
+
+			for(neuron_it = (layer_it - 1)->first_neuron; neuron_it != last_neuron; neuron_it++)
+			{
+				neuron_index = (unsigned int) (neuron_it - first_neuron);
+				errors[neuron_index] *= fann_activation_derived(neuron_it->activation_function,
+					neuron_it->activation_steepness, ann->values[neuron_index],
+					ann->sums[neuron_index]);
+			}
+		}
+	}
+
+	ann->values = saved_values;
+	ann->sums = saved_sums;
+	ann->train_errors = saved_errors;
+
+	/* slopes, with the patterns added in order as fann_update_slopes_batch does */
+	for(layer_it = first_layer + 1; layer_it != last_layer; layer_it++)
+	{
+		last_neuron = layer_it->last_neuron;
+		prev_index = (unsigned int) ((layer_it - 1)->first_neuron - first_neuron);
+		for(neuron_it = layer_it->first_neuron; neuron_it != last_neuron; neuron_it++)
+		{
+			neuron_index = (unsigned int) (neuron_it - first_neuron);
+			num_connections = neuron_it->last_con - neuron_it->first_con;
+			slopes = ann->train_slopes + neuron_it->first_con;
+			for(b = 0; b != num_data; b++)
+			{
+				tmp_error = ann->batch_errors[b * total_neurons + neuron_index];
+				values = ann->batch_values + b * total_neurons + prev_index;
+				fann_axpy(slopes, tmp_error, values, num_connections);
+			}
+		}
+	}
+}
 
 /*
  * Internal train function
  */
 float fann_train_epoch_quickprop(struct fann *ann, struct fann_train_data *data)
 {
-	unsigned int i;
-
 	if(ann->prev_train_slopes == NULL)
 	{
 		fann_clear_train_arrays(ann);
@@ -7753,13 +12722,7 @@ float fann_train_epoch_quickprop(struct fann *ann, struct fann_train_data *data)
 
 	fann_reset_MSE(ann);
 
-	for(i = 0; i < data->num_data; i++)
-	{
-		fann_run(ann, data->input[i]);
-		fann_compute_MSE(ann, data->output[i]);
-		fann_backpropagate_MSE(ann);
-		fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
-	}
+	fann_compute_epoch_slopes(ann, data);
 	fann_update_weights_quickprop(ann, data->num_data, 0, ann->total_connections);
 
 	return fann_get_MSE(ann);
@@ -7770,8 +12733,6 @@ float fann_train_epoch_quickprop(struct fann *ann, struct fann_train_data *data)
  */
 float fann_train_epoch_irpropm(struct fann *ann, struct fann_train_data *data)
 {
-	unsigned int i;
-
 	if(ann->prev_train_slopes == NULL)
 	{
 		fann_clear_train_arrays(ann);
@@ -7779,13 +12740,7 @@ float fann_train_epoch_irpropm(struct fann *ann, struct fann_train_data *data)
 
 	fann_reset_MSE(ann);
 
-	for(i = 0; i < data->num_data; i++)
-	{
-		fann_run(ann, data->input[i]);
-		fann_compute_MSE(ann, data->output[i]);
-		fann_backpropagate_MSE(ann);
-		fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
-	}
+	fann_compute_epoch_slopes(ann, data);
 
 	fann_update_weights_irpropm(ann, 0, ann->total_connections);
 
@@ -7797,8 +12752,6 @@ float fann_train_epoch_irpropm(struct fann *ann, struct fann_train_data *data)
  */
 float fann_train_epoch_sarprop(struct fann *ann, struct fann_train_data *data)
 {
-	unsigned int i;
-
 	if(ann->prev_train_slopes == NULL)
 	{
 		fann_clear_train_arrays(ann);
@@ -7806,13 +12759,7 @@ float fann_train_epoch_sarprop(struct fann *ann, struct fann_train_data *data)
 
 	fann_reset_MSE(ann);
 
-	for(i = 0; i < data->num_data; i++)
-	{
-		fann_run(ann, data->input[i]);
-		fann_compute_MSE(ann, data->output[i]);
-		fann_backpropagate_MSE(ann);
-		fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
-	}
+	fann_compute_epoch_slopes(ann, data);
 
 	fann_update_weights_sarprop(ann, ann->sarprop_epoch, 0, ann->total_connections);
 
@@ -7826,19 +12773,56 @@ float fann_train_epoch_sarprop(struct fann *ann, struct fann_train_data *data)
  */
 float fann_train_epoch_batch(struct fann *ann, struct fann_train_data *data)
 {
-	unsigned int i;
+	fann_reset_MSE(ann);
+
+	fann_compute_epoch_slopes(ann, data);
+
+	fann_update_weights_batch(ann, data->num_data, 0, ann->total_connections);
+
+	return fann_get_MSE(ann);
+}
+
+/*
+ * Internal train function
+ */
+float fann_train_epoch_minibatch(struct fann *ann, struct fann_train_data *data)
+{
+	unsigned int first_data, num_data;
+	unsigned int batch_size = ann->batch_size > 0 ? ann->batch_size : 1;
 
 	fann_reset_MSE(ann);
 
-	for(i = 0; i < data->num_data; i++)
+	for(first_data = 0; first_data < data->num_data; first_data += num_data)
 	{
-		fann_run(ann, data->input[i]);
-		fann_compute_MSE(ann, data->output[i]);
-		fann_backpropagate_MSE(ann);
-		fann_update_slopes_batch(ann, ann->first_layer + 1, ann->last_layer - 1);
+		num_data = fann_min(batch_size, data->num_data - first_data);
+		fann_compute_batch_slopes(ann, data, first_data, num_data);
+		fann_update_weights_batch(ann, num_data, 0, ann->total_connections);
 	}
 
-	fann_update_weights_batch(ann, data->num_data, 0, ann->total_connections);
+	return fann_get_MSE(ann);
+}
+
+/*
+ * Internal train function
+ */
+float fann_train_epoch_adam(struct fann *ann, struct fann_train_data *data)
+{
+	unsigned int first_data, num_data;
+	unsigned int batch_size = ann->batch_size > 0 ? ann->batch_size : 1;
+
+	if(ann->prev_train_slopes == NULL)
+	{
+		fann_clear_train_arrays(ann);
+	}
+
+	fann_reset_MSE(ann);
+
+	for(first_data = 0; first_data < data->num_data; first_data += num_data)
+	{
+		num_data = fann_min(batch_size, data->num_data - first_data);
+		fann_compute_batch_slopes(ann, data, first_data, num_data);
+		fann_update_weights_adam(ann, num_data, 0, ann->total_connections);
+	}
 
 	return fann_get_MSE(ann);
 }
@@ -7860,28 +12844,111 @@ float fann_train_epoch_incremental(struct fann *ann, struct fann_train_data *dat
 	return fann_get_MSE(ann);
 }
 
+/* INTERNAL FUNCTION
+   Incremental training on several threads sharing the weights and the momentum deltas of ann
+   without locks. The first thread trains on ann itself and the others on its parallel_workers,
+   which have their own values, sums and errors. Thread t takes the patterns t, t + num_threads,
+   t + 2 * num_threads... so the threads stay on neighbouring patterns, in the order the
+   single-threaded epoch would see them.
+ */
+float fann_train_epoch_hogwild(struct fann *ann, struct fann_train_data *data)
+{
+#if !defined(DISABLE_PARALLEL_FANN) && defined(_OPENMP)
+	int thread;
+	unsigned int i, num_threads = ann->num_threads;
+	struct fann *worker;
+
+	if(num_threads == 0)
+		num_threads = (unsigned int) omp_get_max_threads();
+	if(num_threads > data->num_data)
+		num_threads = data->num_data;
+
+	if(num_threads > 1 && ann->precision == FANN_PRECISION_DEFAULT)
+	{
+		/* the workers share the deltas of ann, so they must exist before the workers copy it */
+		if(ann->prev_weights_deltas == NULL)
+		{
+			ann->prev_weights_deltas =
+				(fann_type *) calloc(ann->total_connections_allocated, sizeof(fann_type));
+			if(ann->prev_weights_deltas == NULL)
+			{
+				fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
+				return 0;
+			}
+		}
+
+		if(fann_prepare_parallel_workers(ann, num_threads - 1) == 0)
+		{
+			fann_reset_MSE(ann);
+
+			#pragma omp parallel for num_threads(num_threads) schedule(static, 1) private(i, worker)
+			for(thread = 0; thread < (int) num_threads; thread++)
+			{
+				worker = thread == 0 ? ann : ann->parallel_workers + (thread - 1);
+				for(i = (unsigned int) thread; i < data->num_data; i += num_threads)
+				{
+					fann_run(worker, data->input[i]);
+					fann_compute_MSE(worker, data->output[i]);
+					fann_backpropagate_MSE(worker);
+					fann_update_weights(worker);
+				}
+			}
+
+			for(i = 0; i < num_threads - 1; i++)
+			{
+				worker = ann->parallel_workers + i;
+				ann->MSE_value += worker->MSE_value;
+				ann->num_MSE += worker->num_MSE;
+				ann->num_bit_fail += worker->num_bit_fail;
+			}
+			return fann_get_MSE(ann);
+		}
+	}
+#endif
+
+	return fann_train_epoch_incremental(ann, data);
+}
+
 /*
  * Train for one epoch with the selected training algorithm
  */
 FANN_EXTERNAL float FANN_API fann_train_epoch(struct fann *ann, struct fann_train_data *data)
 {
+	float error = 0;
+
 	if(fann_check_input_output_sizes(ann, data) == -1)
 		return 0;
 
 	switch (ann->training_algorithm)
 	{
 	case FANN_TRAIN_QUICKPROP:
-		return fann_train_epoch_quickprop(ann, data);
+		error = fann_train_epoch_quickprop(ann, data);
+		break;
 	case FANN_TRAIN_RPROP:
-		return fann_train_epoch_irpropm(ann, data);
+		error = fann_train_epoch_irpropm(ann, data);
+		break;
 	case FANN_TRAIN_SARPROP:
-		return fann_train_epoch_sarprop(ann, data);
+		error = fann_train_epoch_sarprop(ann, data);
+		break;
 	case FANN_TRAIN_BATCH:
-		return fann_train_epoch_batch(ann, data);
+		error = fann_train_epoch_batch(ann, data);
+		break;
 	case FANN_TRAIN_INCREMENTAL:
-		return fann_train_epoch_incremental(ann, data);
+		error = fann_train_epoch_incremental(ann, data);
+		break;
+	case FANN_TRAIN_MINIBATCH:
+		error = fann_train_epoch_minibatch(ann, data);
+		break;
+	case FANN_TRAIN_ADAM:
+		error = fann_train_epoch_adam(ann, data);
+		break;
+	case FANN_TRAIN_HOGWILD:
+		error = fann_train_epoch_hogwild(ann, data);
+		break;
 	}
-	return 0;
+
+	ann->precision_stale = 1;
+	return error;
 }
 
 FANN_EXTERNAL void FANN_API fann_train_on_data(
@@ -9150,6 +14217,9 @@ void fann_error(struct fann_error *errdat, const enum fann_errno_enum errno_f, .
 	case FANN_E_WRONG_PARAMETERS_FOR_CREATE:
 		strcpy(errstr, "The parameters for create_standard are wrong, either too few parameters provided or a negative/very high value provided.\n");
 		break;
+	case FANN_E_CANT_USE_PRECISION:
+		strcpy(errstr, "Unable to use the selected precision with this network.\n");
+		break;
 	}
 	va_end(ap);
 
@@ -9229,6 +14299,8 @@ FANN_EXTERNAL void FANN_API fann_cascadetrain_on_data(struct fann *ann, struct f
 	unsigned int total_epochs = 0;
 	int desired_error_reached;
 
+	fann_set_connection_mask(ann, NULL);
+
 	if(neurons_between_reports && ann->callback == NULL)
 	{
 		printf("Max neurons %3d. Desired error: %.6f\n", max_neurons, desired_error);
@@ -9296,6 +14368,8 @@ FANN_EXTERNAL void FANN_API fann_cascadetrain_on_data(struct fann *ann, struct f
 	 * since there is no need for them during training.
 	 */
 	fann_set_shortcut_connections(ann);
+
+	ann->precision_stale = 1;
 }
 
 FANN_EXTERNAL void FANN_API fann_cascadetrain_on_file(struct fann *ann, const char *filename,
@@ -9405,6 +14479,9 @@ float fann_train_outputs_epoch(struct fann *ann, struct fann_train_data *data)
 			break;
 		case FANN_TRAIN_BATCH:
 		case FANN_TRAIN_INCREMENTAL:
+		case FANN_TRAIN_MINIBATCH:
+		case FANN_TRAIN_ADAM:
+		case FANN_TRAIN_HOGWILD:
 			fann_error((struct fann_error *) ann, FANN_E_CANT_USE_TRAIN_ALG);
 	}
 
@@ -9429,6 +14506,8 @@ int fann_reallocate_connections(struct fann *ann, unsigned int total_connections
 		return -1;
 	}
 
+	if(fann_unmap_weights(ann) == -1)
+		return -1;
 	ann->weights = (fann_type *) realloc(ann->weights, total_connections * sizeof(fann_type));
 	if(ann->weights == NULL)
 	{
@@ -9482,9 +14561,11 @@ int fann_reallocate_neurons(struct fann *ann, unsigned int total_neurons)
 		return -1;
 	}
 
-	/* Also allocate room for more train_errors */
+	/* Also allocate room for more train_errors, values and sums */
 	ann->train_errors = (fann_type *) realloc(ann->train_errors, total_neurons * sizeof(fann_type));
-	if(ann->train_errors == NULL)
+	ann->values = (fann_type *) realloc(ann->values, total_neurons * sizeof(fann_type));
+	ann->sums = (fann_type *) realloc(ann->sums, total_neurons * sizeof(fann_type));
+	if(ann->train_errors == NULL || ann->values == NULL || ann->sums == NULL)
 	{
 		fann_error((struct fann_error *) ann, FANN_E_CANT_ALLOCATE_MEM);
 		return -1;
@@ -9619,8 +14700,8 @@ int fann_initialize_candidates(struct fann *ann)
 				/* TODO candidates should actually be created both in
 				 * the last layer before the output layer, and in a new layer.
 				 */
-				neurons[candidate_index].value = 0;
-				neurons[candidate_index].sum = 0;
+				ann->values[candidate_index] = 0;
+				ann->sums[candidate_index] = 0;
 
 				neurons[candidate_index].activation_function =
 					ann->cascade_activation_functions[i];
@@ -9730,6 +14811,7 @@ int fann_train_candidates(struct fann *ann, struct fann_train_data *data)
 void fann_update_candidate_slopes(struct fann *ann)
 {
 	struct fann_neuron *neurons = ann->first_layer->first_neuron;
+	fann_type *values = ann->values;
 	struct fann_neuron *first_cand = neurons + ann->total_neurons + 1;
 	struct fann_neuron *last_cand = first_cand + fann_get_cascade_num_candidates(ann);
 	struct fann_neuron *cand_it;
@@ -9755,11 +14837,11 @@ void fann_update_candidate_slopes(struct fann *ann)
 		switch (i)
 		{
 			case 3:
-				cand_sum += weights[2] * neurons[2].value;
+				cand_sum += weights[2] * values[2];
 			case 2:
-				cand_sum += weights[1] * neurons[1].value;
+				cand_sum += weights[1] * values[1];
 			case 1:
-				cand_sum += weights[0] * neurons[0].value;
+				cand_sum += weights[0] * values[0];
 			case 0:
 				break;
 		}
@@ -9767,13 +14849,13 @@ void fann_update_candidate_slopes(struct fann *ann)
 		for(; i != num_connections; i += 4)
 		{
 			cand_sum +=
-				weights[i] * neurons[i].value +
-				weights[i + 1] * neurons[i + 1].value +
-				weights[i + 2] * neurons[i + 2].value + weights[i + 3] * neurons[i + 3].value;
+				weights[i] * values[i] +
+				weights[i + 1] * values[i + 1] +
+				weights[i + 2] * values[i + 2] + weights[i + 3] * values[i + 3];
 		}
 		/*
 		 * for(i = 0; i < num_connections; i++){
-		 * cand_sum += weights[i] * neurons[i].value;
+		 * cand_sum += weights[i] * values[i];
 		 * }
 		 */
 		/* unrolled loop end */
@@ -9789,8 +14871,8 @@ void fann_update_candidate_slopes(struct fann *ann)
 							cand_sum);
 		/* printf("%f = sigmoid(%f);\n", activation, cand_sum); */
 
-		cand_it->sum = cand_sum;
-		cand_it->value = activation;
+		ann->sums[cand_it - neurons] = cand_sum;
+		values[cand_it - neurons] = activation;
 
 		derived = fann_activation_derived(cand_it->activation_function,
 										  cand_it->activation_steepness, activation, cand_sum);
@@ -9828,7 +14910,7 @@ void fann_update_candidate_slopes(struct fann *ann)
 		cand_slopes = ann->train_slopes + cand_it->first_con;
 		for(i = 0; i < num_connections; i++)
 		{
-			cand_slopes[i] -= error_value * neurons[i].value;
+			cand_slopes[i] -= error_value * values[i];
 		}
 	}
 }
@@ -9855,6 +14937,9 @@ void fann_update_candidate_weights(struct fann *ann, unsigned int num_data)
 			break;
 		case FANN_TRAIN_BATCH:
 		case FANN_TRAIN_INCREMENTAL:
+		case FANN_TRAIN_MINIBATCH:
+		case FANN_TRAIN_ADAM:
+		case FANN_TRAIN_HOGWILD:
 			fann_error((struct fann_error *) ann, FANN_E_CANT_USE_TRAIN_ALG);
 			break;
 	}
@@ -10069,6 +15154,8 @@ void fann_add_candidate_neuron(struct fann *ann, struct fann_layer *layer)
 			   neuron_it - ann->first_layer->first_neuron);
 #endif
 		*neuron_it = *(neuron_it - 1);
+		ann->values[neuron_it - ann->first_layer->first_neuron] = ann->values[neuron_it - 1 - ann->first_layer->first_neuron];
+		ann->sums[neuron_it - ann->first_layer->first_neuron] = ann->sums[neuron_it - 1 - ann->first_layer->first_neuron];
 
 		/* move the weights */
 #ifdef CASCADE_DEBUG_FULL
@@ -10096,8 +15183,8 @@ void fann_add_candidate_neuron(struct fann *ann, struct fann_layer *layer)
 	}
 
 	/* Now inititalize the actual neuron */
-	neuron_place->value = 0;
-	neuron_place->sum = 0;
+	ann->values[neuron_place - ann->first_layer->first_neuron] = 0;
+	ann->sums[neuron_place - ann->first_layer->first_neuron] = 0;
 	neuron_place->activation_function = candidate->activation_function;
 	neuron_place->activation_steepness = candidate->activation_steepness;
 	neuron_place->last_con = (neuron_place + 1)->first_con;
@@ -1,11 +1,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
+#include <ctype.h>
 
 #define FANN_NO_DLL
 #define FANN_NO_SEED
-#define DISABLE_PARALLEL_FANN
 
 #include "fann/doublefann.h"
 
@@ -15,12 +16,44 @@
 #define LOAD_NETWORKS 0
 #define TRAIN_NETWORKS 1
 #define SAVE_NETWORKS 1
+#define BINARY_NETWORKS 1
+// Precision of the weights in the bundle, FANN_PRECISION_HALF or FANN_PRECISION_BFLOAT16 make it half as large but round the weights
+#define BINARY_NETWORKS_PRECISION FANN_PRECISION_DEFAULT
 #define IS_INPUT_ZERO_TO_ONE 1
 #define IS_OUTPUT_ZERO_TO_ONE 1
 #define TRAINING_STEP_COUNT 50
+#define PRUNE_CONSTANT_INPUTS 1
+#define MIN_INPUT_VARIANCE 0.0005
+#define INFERENCE_PRECISION FANN_PRECISION_FLOAT
+#define ACTIVATION_APPROXIMATION FANN_APPROXIMATION_FAST
+#define QUANTIZE_NETWORKS 1
+#define CALIBRATION_SIZE 1000
+#define EARLY_EXIT_ENSEMBLE 1
+#define EARLY_EXIT_MAX_DISAGREEMENT 0.002
+#define CONCURRENT_TRAINING 1
+#define DEGRADATION_FIRST_STEP 20
+#define DEGRADATION_SCHEDULE FANN_PRUNING_LINEAR
+#define DEGRADATION_FINAL_SPARSITY 0.85
+#define DEGRADATION_FREQUENCY 1
+#define DEGRADATION_PER_LAYER 0
+#define DEGRADATION_OUTPUT_SPARSITY 0
+#define DEGRADATION_KEEP_BIAS 0
+#define LOTTERY_TICKET 0
+#define LOTTERY_TICKET_REWIND_STEP 0
+#define LOTTERY_TICKET_ROUND_STEPS 5
+#define EARLY_STOPPING 1
+#define VALIDATION_SIZE 1000
+#define VALIDATIONS_PER_STEP 5
+#define EARLY_STOPPING_PATIENCE 2
+#define EARLY_STOPPING_STEP_PATIENCE 3
+#define CHECKPOINTS 1
+#define SPARSITY_SWEEP 0
+#define SPARSITY_SWEEP_POINTS 40
 
 int dataset_size;
 int epoch_count;
+struct fann_pruning_schedule pruning_schedule;
+float degradation_layer_sparsity[2];
 
 struct fann * fann_create_standard_array(unsigned int num_layers, const unsigned int * layers);
 void fann_randomize_weights(struct fann * ann, double min_weight, double max_weight);
@@ -30,76 +63,6 @@ void fann_train_on_file(struct fann *ann, const char *filename, unsigned int max
 enum source_type_t {source_type_test, source_type_train};
 enum input_type_t {input_type_image, input_type_label};
 
-// To avoid calculating a percentile, which would use a lot of memory, this function approaches the percentile iteratively and returns the reached point
-// Usually you pass in 0.5 as degradation (50% connections pruned), it would return 0.495, so it's precise enough.
-float apply_degradation(struct fann * ann, float degradation_percentile) {
-    if (!ann || !ann->weights) {
-        printf("Invalid network\n");
-        return 0;
-    }
-    unsigned int weight_count = 0;
-    fann_type * last_weight = ((fann_type *) ann->weights) + ann->total_connections;
-
-    fann_type min_abs_weight = 999999;
-    fann_type max_abs_weight = 999999;
-
-    for(fann_type * weights = ann->weights; weights != last_weight; weights++) {
-        weight_count++;
-        float weight_abs = *weights > 0 ? *weights : -(*weights);
-
-        if (max_abs_weight == 999999 || weight_abs < max_abs_weight) {
-            max_abs_weight = weight_abs;
-        }
-        if (min_abs_weight == 999999 || weight_abs > min_abs_weight) {
-            min_abs_weight = weight_abs;
-        }
-    }
-
-    fann_type weight_cutoff;
-    fann_type actual = 0;
-    unsigned int below_count;
-
-    float last_actual = 0;
-    float last_last_actual = 0;
-
-    for (int i = 0; i < 20; i++) {
-        weight_cutoff = (min_abs_weight + max_abs_weight) / 2.0;
-        below_count = 0;
-        for(fann_type * weights = ann->weights; weights != last_weight; weights++) {
-            float weight_abs = *weights > 0 ? *weights : -(*weights);
-            if (weight_abs < weight_cutoff) {
-                below_count++;
-            }
-        }
-        last_last_actual = last_actual;
-        last_actual = actual;
-        actual = (float) below_count / (float) weight_count;
-        if (i > 4 && actual == last_actual && last_actual == last_last_actual) {
-            break;
-        }
-        float err = actual > degradation_percentile ? actual - degradation_percentile : degradation_percentile - actual;
-        if (err < 0.0001) {
-            break;
-        }
-        if (actual < degradation_percentile) {
-            max_abs_weight = (min_abs_weight + max_abs_weight) / 2.0;
-        } else {
-            min_abs_weight = (min_abs_weight + max_abs_weight) / 2.0;
-        }
-    }
-
-    below_count = 0;
-    for(fann_type * weights = ann->weights; weights != last_weight; weights++) {
-        float weight_abs = *weights > 0 ? *weights : -(*weights);
-        if (weight_abs < weight_cutoff) {
-            below_count++;
-            *weights = 0;
-        }
-    }
-
-    return (float) below_count / (float) weight_count;
-}
-
 struct idx_struct * create_idx_data_by_loading_file(
     enum source_type_t source_type,
     enum input_type_t input_type
@@ -180,11 +143,68 @@ float random_float_unit(void) {
     return ((float)rand()/(float)(RAND_MAX-1));
 }
 
-struct fann_train_data * create_data_from_idx(struct idx_struct * images, struct idx_struct * labels, int digit) {
+// Returns the initial state of the random stream of a network, so each network draws its own numbers whatever thread trains it
+uint32_t create_random_stream(uint32_t seed, int stream_id) {
+    uint32_t state = seed + 0x9E3779B9u * (uint32_t) (stream_id + 1);
+    state = (state ^ (state >> 16)) * 0x85EBCA6Bu;
+    state = (state ^ (state >> 13)) * 0xC2B2AE35u;
+    state ^= state >> 16;
+    return state != 0 ? state : 0x9E3779B9u;
+}
+
+// Same as random_float_unit but from a stream created by create_random_stream (xorshift32)
+float random_float_stream(uint32_t * state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (float) (x >> 8) / (float) (1 << 24);
+}
+
+// Writes to pixel_map the index of every pixel whose variance across all images is above min_variance and returns how many were written
+// Border pixels of MNIST are zero in almost every image, so they carry no information and only cost connections in the first layer
+unsigned int create_input_pixel_map(struct idx_struct * images, double min_variance, unsigned int * pixel_map) {
+    unsigned int num_images = images->dimensions[0];
+    unsigned int image_size = images->dimensions[1] * images->dimensions[2];
+    double * sum = calloc(image_size, sizeof(double));
+    double * sum_squared = calloc(image_size, sizeof(double));
+    if (!sum || !sum_squared) {
+        printf("Could not allocate pixel statistics\n");
+        free(sum);
+        free(sum_squared);
+        return 0;
+    }
+
+    for (unsigned int i = 0; i < num_images; i++) {
+        uint8_t * image = images->data + i * image_size;
+        for (unsigned int j = 0; j < image_size; j++) {
+            double value = image[j] / 255.0;
+            sum[j] += value;
+            sum_squared[j] += value * value;
+        }
+    }
+
+    unsigned int pixel_count = 0;
+    for (unsigned int j = 0; j < image_size; j++) {
+        double mean = sum[j] / num_images;
+        double variance = sum_squared[j] / num_images - mean * mean;
+        if (variance > min_variance) {
+            pixel_map[pixel_count++] = j;
+        }
+    }
+
+    free(sum);
+    free(sum_squared);
+    return pixel_count;
+}
+
+struct fann_train_data * create_data_from_idx(struct idx_struct * images, struct idx_struct * labels, int digit, const unsigned int * pixel_map, unsigned int pixel_count) {
     struct fann_train_data * data;
     {
         unsigned int num_data = labels->dimensions[0];
-        unsigned int num_input = images->dimensions[1] * images->dimensions[2];
+        unsigned int image_size = images->dimensions[1] * images->dimensions[2];
+        unsigned int num_input = pixel_count;
         data = fann_create_train(num_data, num_input, 1);
         if (!data) {
             printf("Could not allocate training data\n");
@@ -200,7 +220,7 @@ struct fann_train_data * create_data_from_idx(struct idx_struct * images, struct
         for (int i = 0; i < num_data; i++) {
             float value;
             for (int j = 0; j < num_input; j++) {
-                value = images->data[i * num_input + j] / 255.0;
+                value = images->data[i * image_size + pixel_map[j]] / 255.0;
                 data->input[i][j] = value;
             }
             value = (((int) labels->data[i]) == ((int) digit)) ? 1 : 0;
@@ -235,8 +255,146 @@ float evaluate_network(struct fann * ann, struct fann_train_data * data) {
     return (float) (correct_guess_count) / (float) ((float) correct_guess_count + (float) incorrect_guess_count);
 }
 
-struct fann_train_data * create_data_subset(struct fann_train_data * data, unsigned int subset_size, int equalize) {
-    struct fann_train_data * result = fann_create_train(data->num_data > subset_size ? subset_size : data->num_data, data->num_input, data->num_output);
+// Runs every network on the test pairs from first_pair up to (not including) past_pair and returns how many times the network with the highest output was the label
+int evaluate_ensemble(struct fann ** ann, struct idx_struct * images, struct idx_struct * labels, const unsigned int * pixel_map, unsigned int pixel_count, int first_pair, int past_pair) {
+    int correct_guesses = 0;
+
+    int image_size = images->dimensions[1] * images->dimensions[2];
+    int input_size = pixel_count;
+    int output_size = 10;
+    fann_type * input = calloc(input_size, sizeof(fann_type));
+    fann_type * output = calloc(output_size, sizeof(fann_type));
+
+    for (int pair_id = first_pair; pair_id < past_pair; pair_id++) {
+        for (int i = 0; i < input_size; i++) {
+            input[i] = (double) images->data[pair_id * image_size + pixel_map[i]] / 255.0;
+        }
+
+        int highest_id = 0;
+        for (int i = 0; i < 10; i++) {
+            fann_type * single_output = fann_run(ann[i], input);
+            output[i] = single_output[0];
+            if (i == 0 || output[i] > output[highest_id]) {
+                highest_id = i;
+            }
+        }
+
+        if (highest_id == labels->data[pair_id]) {
+            correct_guesses++;
+        }
+    }
+
+    free(input);
+    free(output);
+    return correct_guesses;
+}
+
+// Runs the networks in the given order and stops at the first one whose output reaches the threshold, otherwise returns the digit with the highest output like evaluate_ensemble
+int predict_early_exit(struct fann ** ann, fann_type * input, const int * order, fann_type threshold, int * evaluated_count) {
+    int highest_id = order[0];
+    fann_type highest_output = 0;
+    for (int i = 0; i < 10; i++) {
+        fann_type output = fann_run(ann[order[i]], input)[0];
+        (*evaluated_count)++;
+        if (output >= threshold) {
+            return order[i];
+        }
+        if (i == 0 || output > highest_output) {
+            highest_id = order[i];
+            highest_output = output;
+        }
+    }
+    return highest_id;
+}
+
+// Same decision as predict_early_exit, on outputs that were already computed for all ten networks
+int simulate_early_exit(const fann_type * outputs, const int * order, fann_type threshold) {
+    int highest_id = order[0];
+    for (int i = 0; i < 10; i++) {
+        if (outputs[order[i]] >= threshold) {
+            return order[i];
+        }
+        if (outputs[order[i]] > outputs[highest_id]) {
+            highest_id = order[i];
+        }
+    }
+    return highest_id;
+}
+
+// Learns the order and threshold used by predict_early_exit from the test pairs from first_pair up to (not including) past_pair.
+// The networks that win most often go first, so the loop stops as early as possible, and the threshold is the lowest winning
+// output at which the early exit still agrees with running all ten networks on all but EARLY_EXIT_MAX_DISAGREEMENT of the pairs.
+// Returns HUGE_VAL, which never exits early, if no threshold is good enough.
+fann_type calibrate_early_exit(struct fann ** ann, struct idx_struct * images, const unsigned int * pixel_map, unsigned int pixel_count, int first_pair, int past_pair, int * order) {
+    int pair_count = past_pair - first_pair;
+    int image_size = images->dimensions[1] * images->dimensions[2];
+    fann_type * input = calloc(pixel_count, sizeof(fann_type));
+    fann_type * outputs = calloc(pair_count * 10, sizeof(fann_type));
+    int * full_guesses = calloc(pair_count, sizeof(int));
+    if (!input || !outputs || !full_guesses) {
+        printf("Could not allocate early exit calibration data\n");
+        free(input);
+        free(outputs);
+        free(full_guesses);
+        return HUGE_VAL;
+    }
+
+    int win_count[10] = {0};
+    for (int pair_id = 0; pair_id < pair_count; pair_id++) {
+        for (int i = 0; i < pixel_count; i++) {
+            input[i] = (double) images->data[(first_pair + pair_id) * image_size + pixel_map[i]] / 255.0;
+        }
+        int highest_id = 0;
+        for (int i = 0; i < 10; i++) {
+            outputs[pair_id * 10 + i] = fann_run(ann[i], input)[0];
+            if (outputs[pair_id * 10 + i] > outputs[pair_id * 10 + highest_id]) {
+                highest_id = i;
+            }
+        }
+        full_guesses[pair_id] = highest_id;
+        win_count[highest_id]++;
+    }
+
+    for (int i = 0; i < 10; i++) {
+        order[i] = i;
+    }
+    for (int i = 1; i < 10; i++) {
+        for (int j = i; j > 0 && win_count[order[j]] > win_count[order[j - 1]]; j--) {
+            int swap = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = swap;
+        }
+    }
+
+    // Every winning output is a candidate threshold, a lower threshold exits earlier but disagrees more often
+    fann_type threshold = HUGE_VAL;
+    int max_disagreements = (int) (EARLY_EXIT_MAX_DISAGREEMENT * pair_count);
+    for (int candidate_id = 0; candidate_id < pair_count; candidate_id++) {
+        fann_type candidate = outputs[candidate_id * 10 + full_guesses[candidate_id]];
+        if (candidate >= threshold) {
+            continue;
+        }
+        int disagreements = 0;
+        for (int pair_id = 0; pair_id < pair_count && disagreements <= max_disagreements; pair_id++) {
+            if (simulate_early_exit(outputs + pair_id * 10, order, candidate) != full_guesses[pair_id]) {
+                disagreements++;
+            }
+        }
+        if (disagreements <= max_disagreements) {
+            threshold = candidate;
+        }
+    }
+
+    free(input);
+    free(outputs);
+    free(full_guesses);
+    return threshold;
+}
+
+// Fills subset with randomly selected pairs of data (all of them, in order, if subset is not smaller), returns 0 if it could not
+// The subset is allocated once by the caller and refilled every step, so training does not allocate a new one each time
+int fill_data_subset(struct fann_train_data * subset, struct fann_train_data * data, int equalize, uint32_t * random_stream) {
+    unsigned int subset_size = subset->num_data;
 
     int continue_count = 0;
     for (int i = 0; i < subset_size; i++) {
@@ -244,27 +402,25 @@ struct fann_train_data * create_data_subset(struct fann_train_data * data, unsig
         if (subset_size >= data->num_data) {
             index = i;
         } else {
-            index = random_float_unit() * data->num_data;
+            index = random_float_stream(random_stream) * data->num_data;
         }
 
         if (index < 0 || index >= data->num_data) {
             continue_count++;
             if (continue_count > data->num_data * 2) {
                 printf("Failed at finding index multiple times\n");
-                fann_destroy_train(result);
-                return NULL;
+                return 0;
             }
             i--;
             continue;
         }
 
-        if (data->num_output == 1 && data->output[index][0] == 0 && (random_float_unit() < 0.92)) {
+        if (data->num_output == 1 && data->output[index][0] == 0 && (random_float_stream(random_stream) < 0.92)) {
             if (equalize) {
                 continue_count++;
                 if (continue_count > data->num_data * 2) {
                     printf("Failed at equalizing data multiple times\n");
-                    fann_destroy_train(result);
-                    return NULL;
+                    return 0;
                 }
                 i--;
                 continue;
@@ -272,28 +428,477 @@ struct fann_train_data * create_data_subset(struct fann_train_data * data, unsig
         }
 
         for (int j = 0; j < data->num_input; j++) {
-            result->input[i][j] = data->input[index][j];
+            subset->input[i][j] = data->input[index][j];
         }
         for (int j = 0; j < data->num_output; j++) {
-            result->output[i][j] = data->output[index][j];
+            subset->output[i][j] = data->output[index][j];
+        }
+    }
+
+    return 1;
+}
+
+// State of the early stopping of one network, reached by its training callback through the user data of the network
+struct early_stopping {
+    struct fann_train_data * validation_data;
+    fann_type * best_weights;
+    float best_performance;
+    int is_best_current;
+    unsigned int validations_without_improvement;
+    unsigned int epochs;
+};
+
+// Called by fann_train_on_data every few epochs: keeps the weights with the best validation performance of the step
+// and stops the step after EARLY_STOPPING_PATIENCE validations in a row without improvement
+int FANN_API early_stopping_callback(struct fann * ann, struct fann_train_data * train, unsigned int max_epochs, unsigned int epochs_between_reports, float desired_error, unsigned int epochs, float error) {
+    // The progress of the training comes from the validation set, not from the training error
+    (void) train;
+    (void) max_epochs;
+    (void) epochs_between_reports;
+    (void) desired_error;
+    (void) error;
+    struct early_stopping * state = (struct early_stopping *) fann_get_user_data(ann);
+    float performance = evaluate_network(ann, state->validation_data);
+    state->epochs = epochs;
+    if (performance > state->best_performance) {
+        state->best_performance = performance;
+        state->is_best_current = 1;
+        state->validations_without_improvement = 0;
+        fann_get_weights(ann, state->best_weights);
+    } else {
+        state->is_best_current = 0;
+        state->validations_without_improvement++;
+    }
+    return state->validations_without_improvement >= EARLY_STOPPING_PATIENCE ? -1 : 0;
+}
+
+// Where the training of one network is, saved in front of the network in its checkpoint
+// With LOTTERY_TICKET it also holds the weights the network is rewound to, once they are taken
+struct training_progress {
+    int next_step;
+    int trained_epochs;
+    int steps_without_improvement;
+    uint32_t random_stream;
+    unsigned int rewind_weight_count;
+    fann_type * rewind_weights;
+};
+
+// Writes the progress and the network with all its training state to the checkpoint of the network
+// The previous checkpoint is only replaced once the new one is complete, so a killed process always leaves a usable one
+// The temporary file is handled by the library, which also replaces the previous checkpoint on Windows where rename does not
+int save_checkpoint(struct fann * ann, const struct training_progress * progress, int network_id, int variant) {
+    char path[256];
+    char * temporary_path;
+    snprintf(path, sizeof(path) - 1, "./output/%d-detecting-network-v%d-checkpoint.txt", network_id, variant);
+    FILE * fp = fann_open_temporary_file(NULL, path, "w", &temporary_path);
+    if (!fp) {
+        return 0;
+    }
+    fprintf(fp, "next_step=%d trained_epochs=%d steps_without_improvement=%d random_stream=%u rewind_weight_count=%u\n", progress->next_step, progress->trained_epochs, progress->steps_without_improvement, (unsigned int) progress->random_stream, progress->rewind_weight_count);
+    for (unsigned int i = 0; i < progress->rewind_weight_count; i++) {
+        fprintf(fp, FANNPRINTF " ", progress->rewind_weights[i]);
+    }
+    fprintf(fp, "\n");
+    int saved = fann_save_checkpoint_to_fd(ann, fp);
+    return fann_replace_file(NULL, fp, temporary_path, path, saved) == 0;
+}
+
+// Returns the network saved in the checkpoint of the network and fills in its progress, or NULL if there is no checkpoint
+struct fann * load_checkpoint(struct training_progress * progress, int network_id, int variant) {
+    char path[256];
+    unsigned int random_stream;
+    snprintf(path, sizeof(path) - 1, "./output/%d-detecting-network-v%d-checkpoint.txt", network_id, variant);
+    FILE * fp = fopen(path, "r");
+    if (!fp) {
+        return NULL;
+    }
+    struct fann * ann = NULL;
+    unsigned int read_count = 0;
+    if (fscanf(fp, "next_step=%d trained_epochs=%d steps_without_improvement=%d random_stream=%u rewind_weight_count=%u\n", &progress->next_step, &progress->trained_epochs, &progress->steps_without_improvement, &random_stream, &progress->rewind_weight_count) == 5) {
+        progress->random_stream = random_stream;
+        progress->rewind_weights = progress->rewind_weight_count > 0 ? malloc(progress->rewind_weight_count * sizeof(fann_type)) : NULL;
+        if (progress->rewind_weights || progress->rewind_weight_count == 0) {
+            while (read_count < progress->rewind_weight_count && fscanf(fp, " " FANNSCANF, &progress->rewind_weights[read_count]) == 1) {
+                read_count++;
+            }
+        }
+        if (read_count == progress->rewind_weight_count && fscanf(fp, "\n") == 0) {
+            ann = fann_create_from_checkpoint_fd(fp);
+        }
+    }
+    fclose(fp);
+    if (ann && progress->rewind_weight_count > 0 && progress->rewind_weight_count != fann_get_total_connections(ann)) {
+        fann_destroy(ann);
+        ann = NULL;
+    }
+    if (!ann) {
+        free(progress->rewind_weights);
+        progress->rewind_weights = NULL;
+        progress->rewind_weight_count = 0;
+    }
+    return ann;
+}
+
+// Drops the rows of the steps from first_dropped_step on from a learning csv, the resumed training writes them again
+// The csv is written to a temporary file that replaces it, as the checkpoints are, and is left as it was if that fails
+int trim_learning_csv(const char * path, int first_dropped_step) {
+    char * temporary_path;
+    char line[256];
+    FILE * in = fopen(path, "r");
+    if (!in) {
+        return 0;
+    }
+    FILE * out = fann_open_temporary_file(NULL, path, "w", &temporary_path);
+    if (!out) {
+        fclose(in);
+        return 0;
+    }
+    int written = 0;
+    for (int line_id = 0; written == 0 && fgets(line, sizeof(line), in); line_id++) {
+        // The first line is the header
+        if (line_id == 0 || atoi(line) < first_dropped_step) {
+            written = fputs(line, out) == EOF ? -1 : 0;
+        }
+    }
+    fclose(in);
+    return fann_replace_file(NULL, out, temporary_path, path, written) == 0;
+}
+
+// Trains a network for TRAINING_STEP_COUNT steps of a new subset of its training data each, degrading it in the later steps, and logs its progress to its own csv
+// Only touches the network, its random stream and its csv, so the ten networks can be trained at the same time
+// The subset and the csv are created once, so after the first step a step does not allocate any memory
+// With EARLY_STOPPING each step keeps the weights that did best on the validation data, and the steps before the degradation end
+// once EARLY_STOPPING_STEP_PATIENCE steps in a row did not improve it
+// Starts at the step of progress, and with CHECKPOINTS saves the network and its progress after every step
+// With LOTTERY_TICKET the weights at the start of step LOTTERY_TICKET_REWIND_STEP are kept, and every time the schedule prunes
+// the kept connections go back to them, so each round retrains the smaller network from its early weights
+void train_network(struct fann * ann, struct fann_train_data * train_data, struct fann_train_data * validation_data, struct fann_train_data * test_data, int network_id, int variant, struct training_progress * progress) {
+    char buffer[256];
+    struct fann_train_data * subdata = fann_create_train(train_data->num_data > dataset_size ? dataset_size : train_data->num_data, train_data->num_input, train_data->num_output);
+    if (!subdata) {
+        printf("Network %d - Could not allocate the training subset\n", network_id);
+        return;
+    }
+
+    // The schedule is shared by the networks, the weights they are rewound to are not
+    struct fann_pruning_schedule schedule = pruning_schedule;
+    schedule.rewind_weights = progress->rewind_weights;
+
+    struct early_stopping state = { validation_data, NULL, 0, 0, 0, 0 };
+    unsigned int epochs_between_validations = epoch_count / VALIDATIONS_PER_STEP > 0 ? epoch_count / VALIDATIONS_PER_STEP : 1;
+    if (EARLY_STOPPING) {
+        state.best_weights = malloc(fann_get_total_connections(ann) * sizeof(fann_type));
+        if (!state.best_weights) {
+            printf("Network %d - Could not allocate the best weights\n", network_id);
+            fann_destroy_train(subdata);
+            return;
+        }
+        fann_set_user_data(ann, &state);
+        fann_set_callback(ann, early_stopping_callback);
+    }
+
+    // Write CSV with performance to allow us to verify the progress as it learns
+    snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d-learning.csv", network_id, variant);
+    FILE * fp;
+    if (progress->next_step > 0) {
+        if (!trim_learning_csv(buffer, progress->next_step)) {
+            printf("Network %d - Could not trim the learning csv, the resumed steps are appended to it\n", network_id);
+        }
+        fp = fopen(buffer, "a");
+    } else {
+        fp = fopen(buffer, "w");
+        if (fp) {
+            fprintf(fp, "Step,Epoch,Performance,Dataset Positivity,Degradation\n");
+        }
+    }
+
+    for (int step_id = progress->next_step; step_id < TRAINING_STEP_COUNT; step_id++) {
+        if (!fill_data_subset(subdata, train_data, 1, &progress->random_stream)) {
+            printf("Network %d - Step %d - Could not create the training subset\n", network_id, step_id);
+            break;
+        }
+        float dataset_positivity = 0;
+        {
+            int positive = 0;
+            int negative = 0;
+            for (int i = 0; i < subdata->num_data; i++) {
+                if (subdata->output[i][0] != 0) {
+                    positive++;
+                } else {
+                    negative++;
+                }
+            }
+            if (positive + negative == 0) {
+                dataset_positivity = 0;
+            } else {
+                dataset_positivity = (float) positive / (float) (positive + negative);
+            }
+        }
+
+        // The early stopping can jump past LOTTERY_TICKET_REWIND_STEP, the weights are then the ones the degradation starts from
+        if (LOTTERY_TICKET && !progress->rewind_weights && step_id >= LOTTERY_TICKET_REWIND_STEP) {
+            progress->rewind_weights = malloc(fann_get_total_connections(ann) * sizeof(fann_type));
+            if (!progress->rewind_weights) {
+                printf("Network %d - Step %d - Could not allocate the rewind weights\n", network_id, step_id);
+                break;
+            }
+            progress->rewind_weight_count = fann_get_total_connections(ann);
+            fann_get_weights(ann, progress->rewind_weights);
+            schedule.rewind_weights = progress->rewind_weights;
+        }
+
+        // Prunes the connections with the smallest weights to the sparsity of the schedule for this step
+        // The pruned connections are masked, so training does not bring them back and skips them once few are left
+        float real_degradation = fann_prune_on_schedule(ann, &schedule, step_id);
+
+        float performance = 0;
+        if (fp) {
+            performance = evaluate_network(ann, test_data);
+            fprintf(fp, "%d,%d,", step_id, progress->trained_epochs);
+            fprintf(fp, "%.5f,%.4f,", performance, dataset_positivity);
+            fprintf(fp, real_degradation == 0 ? "%.0f" : "%.6f", real_degradation);
+            fprintf(fp, "\n");
+            fflush(fp);
+        }
+
+        printf("Network %d/%d - Step %d/%d - Perf: %.2f %% - Positivity: %.2f %% - Degradation: %.2f %%\n", network_id, 10, step_id, TRAINING_STEP_COUNT, 100.0 * performance, 100.0 * dataset_positivity, 100.0 * real_degradation);
+
+        float start_performance = 0;
+        if (EARLY_STOPPING) {
+            start_performance = evaluate_network(ann, validation_data);
+            state.best_performance = start_performance;
+            state.is_best_current = 1;
+            state.validations_without_improvement = 0;
+            state.epochs = epoch_count;
+            fann_get_weights(ann, state.best_weights);
+        }
+
+        fann_train_on_data(
+            ann,
+            subdata,
+            epoch_count, // max epochs
+            EARLY_STOPPING ? epochs_between_validations : epoch_count / 2, // epochs between reports
+            0.0001 // desired error
+        );
+        progress->trained_epochs += EARLY_STOPPING ? state.epochs : epoch_count;
+
+        if (EARLY_STOPPING) {
+            if (!state.is_best_current) {
+                fann_set_weights(ann, state.best_weights);
+            }
+            progress->steps_without_improvement = state.best_performance > start_performance ? 0 : progress->steps_without_improvement + 1;
+            if (step_id < (int) pruning_schedule.first_step && progress->steps_without_improvement >= EARLY_STOPPING_STEP_PATIENCE) {
+                printf("Network %d/%d - Step %d/%d - Validation stopped improving, starting the degradation\n", network_id, 10, step_id, TRAINING_STEP_COUNT);
+                step_id = pruning_schedule.first_step - 1;
+            }
+        }
+
+        progress->next_step = step_id + 1;
+        if (CHECKPOINTS && !save_checkpoint(ann, progress, network_id, variant)) {
+            printf("Network %d - Step %d - Could not save the checkpoint\n", network_id, step_id);
         }
     }
 
-    return result;
+    if (EARLY_STOPPING) {
+        fann_set_callback(ann, NULL);
+        fann_set_user_data(ann, NULL);
+        free(state.best_weights);
+    }
+    free(progress->rewind_weights);
+    progress->rewind_weights = NULL;
+    progress->rewind_weight_count = 0;
+    if (fp) {
+        fclose(fp);
+    }
+    fann_destroy_train(subdata);
+}
+
+// Prunes a copy of a trained network to more and more sparsity, up to 99 %, without training it again, and logs its performance at each point to its own csv
+// Pruning only removes weights, so the sums of the hidden layer are cached once for the whole test data and only the contributions
+// of the removed weights are subtracted from them at each point, instead of running every pair through all the connections again
+void sweep_sparsity(struct fann * trained_ann, struct fann_train_data * test_data, int network_id, int variant) {
+    char buffer[256];
+    struct fann * ann = fann_copy(trained_ann);
+    struct fann_sum_cache * cache = ann ? fann_create_sum_cache(ann, test_data) : NULL;
+    snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d-sparsity.csv", network_id, variant);
+    FILE * fp = fopen(buffer, "w");
+    if (!cache || !fp) {
+        printf("Network %d - Could not sweep the sparsity\n", network_id);
+        fann_destroy_sum_cache(cache);
+        if (ann) {
+            fann_destroy(ann);
+        }
+        if (fp) {
+            fclose(fp);
+        }
+        return;
+    }
+
+    fprintf(fp, "Sparsity,Performance\n");
+    clock_t start = clock();
+    for (int point_id = 0; point_id <= SPARSITY_SWEEP_POINTS; point_id++) {
+        float sparsity = 0.99 * point_id / SPARSITY_SWEEP_POINTS;
+        // Prunes the same connections the degradation does
+        if (DEGRADATION_PER_LAYER) {
+            fann_prune_smallest_layer_connections(ann, 1, sparsity, DEGRADATION_KEEP_BIAS);
+        } else {
+            fann_prune_smallest_connections(ann, sparsity);
+        }
+        fann_update_sum_cache(ann, cache);
+
+        unsigned int correct_guess_count = 0;
+        for (int i = 0; i < test_data->num_data; i++) {
+            fann_type result = fann_run_sum_cache(ann, cache, i)[0];
+            fann_type expected = test_data->output[i][0];
+            if ((result > 0.5) == (expected > 0.5)) {
+                correct_guess_count++;
+            }
+        }
+        float real_sparsity = (float) (fann_get_total_connections(ann) - fann_get_total_active_connections(ann)) / (float) fann_get_total_connections(ann);
+        fprintf(fp, "%.6f,%.5f\n", real_sparsity, (float) correct_guess_count / (float) test_data->num_data);
+    }
+    printf("Network %d: Swept %d sparsities in %.3f s\n", network_id, SPARSITY_SWEEP_POINTS + 1, (double) (clock() - start) / CLOCKS_PER_SEC);
+
+    fclose(fp);
+    fann_destroy_sum_cache(cache);
+    fann_destroy(ann);
+}
+
+// Saves the ten networks in one bundle with everything needed to use them: the hyperparameters of the variant and the input preprocessing
+// The bundle is replaced in one rename, so a process loading it never sees networks from two different runs
+int save_network_bundle(struct fann ** ann, int variant, int image_width, int image_height, const unsigned int * pixel_map, unsigned int pixel_count) {
+    char path[256];
+    size_t metadata_size = 512 + 12 * (size_t) pixel_count;
+    char * metadata = malloc(metadata_size);
+    if (!metadata) {
+        return 0;
+    }
+    int length = snprintf(metadata, metadata_size, "variant=%d\ndataset_size=%d\nepoch_count=%d\ninput_zero_to_one=%d\nmin_input_variance=%f\nimage_width=%d\nimage_height=%d\npixel_count=%u\npixel_map=", variant, dataset_size, epoch_count, IS_INPUT_ZERO_TO_ONE, MIN_INPUT_VARIANCE, image_width, image_height, pixel_count);
+    for (unsigned int i = 0; i < pixel_count; i++) {
+        length += snprintf(metadata + length, metadata_size - length, i == 0 ? "%u" : " %u", pixel_map[i]);
+    }
+    snprintf(metadata + length, metadata_size - length, "\n");
+    snprintf(path, sizeof(path) - 1, "./output/detecting-networks-v%d.bundle", variant);
+    int saved = fann_save_bundle(path, ann, 10, metadata, BINARY_NETWORKS_PRECISION) == 0;
+    free(metadata);
+    return saved;
+}
+
+// Loads the ten networks of a bundle in one read, and replaces the pixel map with the one they were trained with
+// The bundle must come from the same variant and images, with the same input range, since the networks cannot work with other inputs
+int load_network_bundle(struct fann ** ann, int variant, int image_width, int image_height, unsigned int * pixel_map, unsigned int * pixel_count) {
+    char path[256];
+    char * metadata;
+    int bundle_variant, input_zero_to_one, bundle_image_width, bundle_image_height, offset;
+    unsigned int bundle_pixel_count;
+    float min_input_variance;
+    snprintf(path, sizeof(path) - 1, "./output/detecting-networks-v%d.bundle", variant);
+    if (fann_create_from_bundle(path, ann, 10, &metadata) != 10) {
+        printf("Error: could not load the networks from \"%s\"\n", path);
+        return 0;
+    }
+
+    int loaded = sscanf(metadata, "variant=%d\ndataset_size=%d\nepoch_count=%d\ninput_zero_to_one=%d\nmin_input_variance=%f\nimage_width=%d\nimage_height=%d\npixel_count=%u\npixel_map=%n", &bundle_variant, &dataset_size, &epoch_count, &input_zero_to_one, &min_input_variance, &bundle_image_width, &bundle_image_height, &bundle_pixel_count, &offset) == 8
+        && bundle_variant == variant && input_zero_to_one == IS_INPUT_ZERO_TO_ONE && bundle_image_width == image_width && bundle_image_height == image_height
+        && bundle_pixel_count > 0 && bundle_pixel_count <= (unsigned int) (image_width * image_height);
+    char * position = metadata + (loaded ? offset : 0);
+    for (unsigned int i = 0; loaded && i < bundle_pixel_count; i++) {
+        char * end;
+        unsigned long pixel = strtoul(position, &end, 10);
+        loaded = end != position && pixel < (unsigned long) (image_width * image_height);
+        pixel_map[i] = (unsigned int) pixel;
+        position = end;
+    }
+    for (int i = 0; loaded && i < 10; i++) {
+        loaded = fann_get_num_input(ann[i]) == bundle_pixel_count;
+    }
+    free(metadata);
+
+    if (!loaded) {
+        printf("Error: the networks from \"%s\" do not match variant %d and its %dx%d images\n", path, variant, image_width, image_height);
+        for (int i = 0; i < 10; i++) {
+            fann_destroy(ann[i]);
+        }
+        return 0;
+    }
+    *pixel_count = bundle_pixel_count;
+    printf("Loaded the networks from \"%s\", their pixel map keeps the pixels with a variance above %f\n", path, min_input_variance);
+    return 1;
 }
 
 int main(int argn, char ** argv) {
     srand((unsigned int) time(0));
 
     int variant = argn >= 2 ? atoi(argv[1]) : 0;
-    if (variant < 0 || variant > 7) {
+    if (variant < 0 || variant > 8) {
         printf("Variant %d out of range\n", variant);
         return 1;
     }
 
     printf("Variant: %d\n", variant);
 
+    // The degradation follows the DEGRADATION_ defines, which the command line can override to try other schedules:
+    // main [variant] [linear|cubic|exponential] [final sparsity] [first step] [last step] [frequency]
+    // With LOTTERY_TICKET the schedule prunes once per round of LOTTERY_TICKET_ROUND_STEPS steps, and the last round retrains at the final sparsity
+    fann_init_pruning_schedule(&pruning_schedule, DEGRADATION_SCHEDULE, DEGRADATION_FINAL_SPARSITY, DEGRADATION_FIRST_STEP, LOTTERY_TICKET ? TRAINING_STEP_COUNT - LOTTERY_TICKET_ROUND_STEPS : TRAINING_STEP_COUNT - 1);
+    pruning_schedule.frequency = LOTTERY_TICKET ? LOTTERY_TICKET_ROUND_STEPS : DEGRADATION_FREQUENCY;
+    if (argn >= 3) {
+        int schedule_id = -1;
+        // The command line takes the names of FANN_PRUNING_SCHEDULE_NAMES in lower case and without their prefix
+        for (int i = 0; i < (int) (sizeof(FANN_PRUNING_SCHEDULE_NAMES) / sizeof(FANN_PRUNING_SCHEDULE_NAMES[0])); i++) {
+            const char * name = FANN_PRUNING_SCHEDULE_NAMES[i] + strlen("FANN_PRUNING_");
+            size_t length = 0;
+            while (name[length] && tolower((unsigned char) name[length]) == argv[2][length]) {
+                length++;
+            }
+            if (!name[length] && !argv[2][length]) {
+                schedule_id = i;
+            }
+        }
+        if (schedule_id < 0) {
+            printf("Unknown pruning schedule \"%s\", use linear, cubic or exponential\n", argv[2]);
+            return 1;
+        }
+        pruning_schedule.schedule = (enum fann_pruning_schedule_enum) schedule_id;
+    }
+    if (argn >= 4) {
+        pruning_schedule.final_sparsity = atof(argv[3]);
+    }
+    if (argn >= 5) {
+        pruning_schedule.first_step = atoi(argv[4]);
+    }
+    if (argn >= 6) {
+        pruning_schedule.last_step = atoi(argv[5]);
+    }
+    if (argn >= 7) {
+        pruning_schedule.frequency = atoi(argv[6]);
+    }
+    if (pruning_schedule.final_sparsity < 0 || pruning_schedule.final_sparsity >= 1 || pruning_schedule.first_step > pruning_schedule.last_step || pruning_schedule.last_step >= TRAINING_STEP_COUNT || pruning_schedule.frequency == 0 || (LOTTERY_TICKET && LOTTERY_TICKET_REWIND_STEP >= pruning_schedule.first_step)) {
+        printf("Invalid pruning schedule\n");
+        return 1;
+    }
+    // With DEGRADATION_PER_LAYER the final sparsity is the one of the connections into the hidden layer, which has almost all of them,
+    // while the few connections into the output layer stop at DEGRADATION_OUTPUT_SPARSITY
+    if (DEGRADATION_PER_LAYER) {
+        degradation_layer_sparsity[0] = pruning_schedule.final_sparsity;
+        degradation_layer_sparsity[1] = DEGRADATION_OUTPUT_SPARSITY;
+        pruning_schedule.layer_sparsity = degradation_layer_sparsity;
+    }
+    pruning_schedule.keep_bias = DEGRADATION_KEEP_BIAS;
+    printf("Degradation: %s to %.2f %% from step %u to %u, every %u steps", FANN_PRUNING_SCHEDULE_NAMES[pruning_schedule.schedule], 100.0 * pruning_schedule.final_sparsity, pruning_schedule.first_step, pruning_schedule.last_step, pruning_schedule.frequency);
+    if (DEGRADATION_PER_LAYER) {
+        printf(", %.2f %% for the output layer", 100.0 * DEGRADATION_OUTPUT_SPARSITY);
+    }
+    if (DEGRADATION_KEEP_BIAS) {
+        printf(", keeping the bias connections");
+    }
+    if (LOTTERY_TICKET) {
+        printf(", rewinding to the weights of step %d", LOTTERY_TICKET_REWIND_STEP);
+    }
+    printf("\n");
+
     struct fann_train_data * train_data[10];
+    struct fann_train_data * validation_data[10];
     struct fann_train_data * test_data[10];
     struct idx_struct * train_images = create_idx_data_by_loading_file(source_type_train, input_type_image);
     struct idx_struct * train_labels = create_idx_data_by_loading_file(source_type_train, input_type_label);
@@ -301,6 +906,9 @@ int main(int argn, char ** argv) {
     struct idx_struct * test_labels = create_idx_data_by_loading_file(source_type_test, input_type_label);
     int image_width;
     int image_height;
+    unsigned int * pixel_map;
+    unsigned int pixel_count;
+    struct fann * ann[10];
     {
         printf("Reading input idx files.\n");
 
@@ -308,16 +916,56 @@ int main(int argn, char ** argv) {
             return 1;
         }
 
+        image_width = train_images->dimensions[1];
+        image_height = train_images->dimensions[2];
+
+        pixel_map = malloc(image_width * image_height * sizeof(unsigned int));
+        if (!pixel_map) {
+            printf("Could not allocate the pixel map\n");
+            return 1;
+        }
+        // The bundle has the pixel map of its networks, which must not change with the images they are evaluated on
+        if (LOAD_NETWORKS && BINARY_NETWORKS) {
+            printf("Loading networks.\n");
+            if (!load_network_bundle(ann, variant, image_width, image_height, pixel_map, &pixel_count)) {
+                return 1;
+            }
+        } else if (PRUNE_CONSTANT_INPUTS) {
+            pixel_count = create_input_pixel_map(train_images, MIN_INPUT_VARIANCE, pixel_map);
+            if (pixel_count == 0) {
+                printf("No pixel has a variance above %f\n", MIN_INPUT_VARIANCE);
+                return 1;
+            }
+        } else {
+            pixel_count = image_width * image_height;
+            for (unsigned int i = 0; i < pixel_count; i++) {
+                pixel_map[i] = i;
+            }
+        }
+        printf("Using %d of %d pixels as input.\n", pixel_count, image_width * image_height);
+
         printf("Creating dataset from file data.\n");
         for (int i = 0; i < 10; i++) {
-            train_data[i] = create_data_from_idx(train_images, train_labels, i);
-            test_data[i] = create_data_from_idx(test_images, test_labels, i);
+            train_data[i] = create_data_from_idx(train_images, train_labels, i, pixel_map, pixel_count);
+            test_data[i] = create_data_from_idx(test_images, test_labels, i, pixel_map, pixel_count);
             if (!train_data[i] || !test_data[i]) {
                 return 1;
             }
+            // The last VALIDATION_SIZE training pairs are only used to decide when to stop training, never to train
+            if (EARLY_STOPPING) {
+                if (train_data[i]->num_data <= VALIDATION_SIZE) {
+                    printf("Early stopping needs more than %d training pairs\n", VALIDATION_SIZE);
+                    return 1;
+                }
+                validation_data[i] = fann_subset_train_data(train_data[i], train_data[i]->num_data - VALIDATION_SIZE, VALIDATION_SIZE);
+                if (!validation_data[i]) {
+                    return 1;
+                }
+                train_data[i]->num_data -= VALIDATION_SIZE;
+            } else {
+                validation_data[i] = NULL;
+            }
         }
-        image_width = train_images->dimensions[1];
-        image_height = train_images->dimensions[2];
     }
     destroy_idx_data(train_images);
     destroy_idx_data(train_labels);
@@ -342,29 +990,35 @@ int main(int argn, char ** argv) {
         */
     }
 
-    struct fann * ann[10];
     {
-        printf(LOAD_NETWORKS ? "Loading networks.\n" : "Creating networks.\n");
-        int layers[] = { image_width * image_height, 114, 1 };
+        if (!(LOAD_NETWORKS && BINARY_NETWORKS)) {
+            printf(LOAD_NETWORKS ? "Loading networks.\n" : "Creating networks.\n");
+        }
+        int layers[] = { pixel_count, 114, 1 };
         for (int i = 0; i < 10; i++) {
-            if (LOAD_NETWORKS) {
+            if (LOAD_NETWORKS && BINARY_NETWORKS) {
+                // Already loaded from the bundle with the pixel map, its weights are mapped instead of parsed
+            } else if (LOAD_NETWORKS) {
                 char buffer[256];
                 snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d.txt", i, variant);
                 ann[i] = fann_create_from_file(buffer);
                 if (!ann[i]) {
                     printf("Error: could not load network from \"%s\"\n", buffer);
                     return 1;
+                } else if (fann_get_num_input(ann[i]) != pixel_count) {
+                    printf("Error: network from \"%s\" has %d inputs but the pixel map has %d\n", buffer, fann_get_num_input(ann[i]), pixel_count);
+                    return 1;
                 }
             } else {
-                enum fann_train_enum training_options[] = {FANN_TRAIN_INCREMENTAL, FANN_TRAIN_BATCH, FANN_TRAIN_INCREMENTAL, FANN_TRAIN_QUICKPROP, FANN_TRAIN_BATCH, FANN_TRAIN_BATCH, FANN_TRAIN_BATCH, FANN_TRAIN_QUICKPROP};
-                enum fann_activationfunc_enum hidden_activation_options[] = {FANN_SIGMOID, FANN_LEAKY_RELU, FANN_LEAKY_RELU, FANN_COS, FANN_SIGMOID, FANN_SIN, FANN_SIN, FANN_SIGMOID};
-                enum fann_activationfunc_enum output_activation_options[] = {FANN_ELLIOT, FANN_LINEAR, FANN_ELLIOT, FANN_GAUSSIAN, FANN_LINEAR, FANN_SIGMOID, FANN_LEAKY_RELU, FANN_LINEAR_PIECE};
-                int dataset_size_options[] = {800, 500, 200, 500, 500, 800, 500, 650};
-                int epoch_count_options[] = {10, 70, 70, 190, 250, 250, 310, 190};
-                enum fann_errorfunc_enum errorfunc_options[] = {FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_LINEAR};
-                int hidden_layer_sizes[] = {104, 122, 122, 122, 31, 67, 49, 104};
-                float randomize_range_options[] = {0.25, 0.1, 0.1, 0.5, 0.1, 0.1, 0.1, 0.5};
-                float learning_rate_options[] = {0.59, 0.23, 0.5, 0.5, 0.14, 0.59, 0.59, 0.77};
+                enum fann_train_enum training_options[] = {FANN_TRAIN_INCREMENTAL, FANN_TRAIN_BATCH, FANN_TRAIN_INCREMENTAL, FANN_TRAIN_QUICKPROP, FANN_TRAIN_BATCH, FANN_TRAIN_BATCH, FANN_TRAIN_BATCH, FANN_TRAIN_QUICKPROP, FANN_TRAIN_ADAM};
+                enum fann_activationfunc_enum hidden_activation_options[] = {FANN_SIGMOID, FANN_LEAKY_RELU, FANN_LEAKY_RELU, FANN_COS, FANN_SIGMOID, FANN_SIN, FANN_SIN, FANN_SIGMOID, FANN_SIGMOID};
+                enum fann_activationfunc_enum output_activation_options[] = {FANN_ELLIOT, FANN_LINEAR, FANN_ELLIOT, FANN_GAUSSIAN, FANN_LINEAR, FANN_SIGMOID, FANN_LEAKY_RELU, FANN_LINEAR_PIECE, FANN_ELLIOT};
+                int dataset_size_options[] = {800, 500, 200, 500, 500, 800, 500, 650, 800};
+                int epoch_count_options[] = {10, 70, 70, 190, 250, 250, 310, 190, 20};
+                enum fann_errorfunc_enum errorfunc_options[] = {FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_TANH, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_LINEAR, FANN_ERRORFUNC_TANH};
+                int hidden_layer_sizes[] = {104, 122, 122, 122, 31, 67, 49, 104, 104};
+                float randomize_range_options[] = {0.25, 0.1, 0.1, 0.5, 0.1, 0.1, 0.1, 0.5, 0.25};
+                float learning_rate_options[] = {0.59, 0.23, 0.5, 0.5, 0.14, 0.59, 0.59, 0.77, 0.002};
 
                 layers[1] = hidden_layer_sizes[variant];
 
@@ -383,7 +1037,9 @@ int main(int argn, char ** argv) {
                 fann_set_learning_rate(ann[i], learning_rate_options[variant]);
                 fann_randomize_weights(ann[i], -randomize_range, randomize_range);
             }
+            fann_set_activation_approximation(ann[i], ACTIVATION_APPROXIMATION);
         }
+        printf("Using %s for the activation functions.\n", FANN_APPROXIMATION_NAMES[ACTIVATION_APPROXIMATION]);
     }
 
     if (TRAIN_NETWORKS) {
@@ -394,72 +1050,58 @@ int main(int argn, char ** argv) {
         }
 
         printf("Training networks.\n");
-        {
-            char buffer[256];
-            for (int i = 0; i < 10; i++) {
-                for (int step_id = 0; step_id < TRAINING_STEP_COUNT; step_id++) {
-                    struct fann_train_data * subdata = create_data_subset(train_data[i], dataset_size, 1);
-                    float dataset_positivity = 0;
-                    {
-                        int positive = 0;
-                        int negative = 0;
-                        for (int i = 0; i < subdata->num_data; i++) {
-                            if (subdata->output[i][0] != 0) {
-                                positive++;
-                            } else {
-                                negative++;
-                            }
-                        }
-                        if (positive + negative == 0) {
-                            dataset_positivity = 0;
-                        } else {
-                            dataset_positivity = (float) positive / (float) (positive + negative);
-                        }
-                    }
-
-                    float degradation = 0.85 * ((step_id - 20.0) / (float) (TRAINING_STEP_COUNT - 1.0 - 20.0));
-                    float real_degradation = 0;
-                    if (degradation < 0.0) { degradation = 0; }
-                    if (degradation > 0.0) {
-                        real_degradation = apply_degradation(ann[i], degradation);
-                    }
-
-                    // Write CSV with performance to allow us to verify the progress as it learns
-                    float performance = 0;
-                    {
-                        snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d-learning.csv", i, variant);
-                        FILE * fp = fopen(buffer, step_id == 0 ? "w" : "a");
-                        if (fp) {
-                            if (step_id == 0) {
-                                fprintf(fp, "Step,Epoch,Performance,Dataset Positivity,Degradation\n");
-                            }
-                            performance = evaluate_network(ann[i], test_data[i]);
-                            fprintf(fp, "%d,%d,", step_id, step_id * epoch_count);
-                            fprintf(fp, "%.5f,%.4f,", performance, dataset_positivity);
-                            fprintf(fp, real_degradation == 0 ? "%.0f" : "%.6f", real_degradation);
-                            fprintf(fp, "\n");
-                            fclose(fp);
-                        }
-                    }
-
-                    printf("Network %d/%d - Step %d/%d - Perf: %.2f %% - Positivity: %.2f %% - Degradation: %.2f %%\n", i, 10, step_id, TRAINING_STEP_COUNT, 100.0 * performance, 100.0 * dataset_positivity, 100.0 * real_degradation);
-
-                    fann_train_on_data(
-                        ann[i],
-                        subdata,
-                        epoch_count, // max epochs
-                        epoch_count / 2, // epochs between reports
-                        0.0001 // desired error
-                    );
-
-                    fann_destroy_train(subdata);
-
-                    if (step_id+1 >= TRAINING_STEP_COUNT) {
-                        apply_degradation(ann[i], degradation);
-                    }
+        uint32_t random_seed = (uint32_t) rand();
+        struct training_progress progress[10];
+        for (int i = 0; i < 10; i++) {
+            progress[i].next_step = 0;
+            progress[i].trained_epochs = 0;
+            progress[i].steps_without_improvement = 0;
+            progress[i].random_stream = create_random_stream(random_seed, i);
+            progress[i].rewind_weight_count = 0;
+            progress[i].rewind_weights = NULL;
+            // A checkpoint left by an interrupted run replaces the new network, and its training goes on from the step it was in
+            if (CHECKPOINTS) {
+                struct fann * resumed_ann = load_checkpoint(&progress[i], i, variant);
+                if (resumed_ann && fann_get_num_input(resumed_ann) != pixel_count) {
+                    printf("Error: the checkpoint of network %d has %d inputs but the pixel map has %d\n", i, fann_get_num_input(resumed_ann), pixel_count);
+                    return 1;
                 }
+                if (resumed_ann) {
+                    printf("Network %d: Resuming at step %d\n", i, progress[i].next_step);
+                    fann_destroy(ann[i]);
+                    ann[i] = resumed_ann;
+                }
+            }
+            // The networks are trained concurrently, so each epoch stays on the thread of its network
+            if (CONCURRENT_TRAINING) {
+                fann_set_num_threads(ann[i], 1);
             }
         }
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(CONCURRENT_TRAINING)
+#endif
+        for (int i = 0; i < 10; i++) {
+            train_network(ann[i], train_data[i], validation_data[i], test_data[i], i, variant, &progress[i]);
+        }
+    }
+
+    if (SPARSITY_SWEEP) {
+        printf("Sweeping the sparsity of the networks.\n");
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(CONCURRENT_TRAINING)
+#endif
+        for (int i = 0; i < 10; i++) {
+            sweep_sparsity(ann[i], test_data[i], i, variant);
+        }
+    }
+
+    // Training always happens in fann_type (double), only the final inference uses INFERENCE_PRECISION
+    printf("Using %s for inference.\n", FANN_PRECISION_NAMES[INFERENCE_PRECISION]);
+    for (int i = 0; i < 10; i++) {
+        if (fann_set_precision(ann[i], INFERENCE_PRECISION) != 0) {
+            printf("Error: could not set the precision of network %d\n", i);
+            return 1;
+        }
     }
 
     printf("Evaluating networks.\n");
@@ -470,56 +1112,99 @@ int main(int argn, char ** argv) {
 
     printf("Evaluating all models together.\n");
     {
-        int correct_guesses = 0;
-        int incorrect_guesses = 0;
-
-        int input_size = image_width * image_height;
-        int output_size = 10;
-        fann_type * input = calloc(input_size, sizeof(fann_type));
-        fann_type * output = calloc(output_size, sizeof(fann_type));
         int test_count = test_labels->dimensions[0];
+        int correct_guesses = evaluate_ensemble(ann, test_images, test_labels, pixel_map, pixel_count, 0, test_count);
+        int incorrect_guesses = test_count - correct_guesses;
 
-        int has_shown = 0;
+        printf("Guessed %d correctly and %d incorrectly out of %d. Performance: %.2f %%\n", correct_guesses, incorrect_guesses, correct_guesses + incorrect_guesses, 100.0 * (float) correct_guesses / (float)(correct_guesses + incorrect_guesses));
+    }
 
-        for (int pair_id = 0; pair_id < test_count; pair_id++) {
-            for (int i = 0; i < input_size; i++) {
-                input[i] = (double) test_images->data[pair_id * input_size + i] / 255.0;
+    // The first CALIBRATION_SIZE test pairs pick the int8 value ranges, the rest measure what quantizing costs in accuracy
+    if (QUANTIZE_NETWORKS && test_labels->dimensions[0] <= CALIBRATION_SIZE) {
+        printf("Skipping int8 quantization, it needs more than %d test pairs.\n", CALIBRATION_SIZE);
+    } else if (QUANTIZE_NETWORKS) {
+        int test_count = test_labels->dimensions[0];
+        printf("Calibrating int8 networks on %d test pairs.\n", CALIBRATION_SIZE);
+        float performance[2][10];
+        for (int i = 0; i < 10; i++) {
+            struct fann_train_data * calibration_data = fann_subset_train_data(test_data[i], 0, CALIBRATION_SIZE);
+            struct fann_train_data * held_out_data = fann_subset_train_data(test_data[i], CALIBRATION_SIZE, test_count - CALIBRATION_SIZE);
+            if (!calibration_data || !held_out_data || fann_calibrate_int8(ann[i], calibration_data) != 0) {
+                printf("Error: could not calibrate network %d\n", i);
+                return 1;
             }
+            performance[0][i] = evaluate_network(ann[i], held_out_data);
+            fann_set_precision(ann[i], FANN_PRECISION_INT8);
+            performance[1][i] = evaluate_network(ann[i], held_out_data);
+            fann_set_precision(ann[i], INFERENCE_PRECISION);
+            fann_destroy_train(calibration_data);
+            fann_destroy_train(held_out_data);
+        }
 
-            int highest_id = 0;
-            for (int i = 0; i < 10; i++) {
-                fann_type * single_output = fann_run(ann[i], input);
-                output[i] = single_output[0];
-                if (i == 0 || output[i] > output[highest_id]) {
-                    highest_id = i;
-                }
-            }
+        clock_t start = clock();
+        int correct_guesses = evaluate_ensemble(ann, test_images, test_labels, pixel_map, pixel_count, CALIBRATION_SIZE, test_count);
+        double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
 
-            if (highest_id == test_labels->data[pair_id]) {
-                correct_guesses++;
-            } else {
-                incorrect_guesses++;
+        for (int i = 0; i < 10; i++) {
+            if (fann_set_precision(ann[i], FANN_PRECISION_INT8) != 0) {
+                printf("Error: could not quantize network %d\n", i);
+                return 1;
             }
+        }
+        start = clock();
+        int quantized_correct_guesses = evaluate_ensemble(ann, test_images, test_labels, pixel_map, pixel_count, CALIBRATION_SIZE, test_count);
+        double quantized_seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
 
-            /*
-                if (has_shown < 3 && highest_id != test_labels->data[pair_id]) {
-                    has_shown++;
-                    print_grayscale_image(input, image_width, image_height);
-                    printf("At train id %d - Expected: %d, got: %d (", pair_id, test_labels->data[pair_id], highest_id);
-                    for (int i = 0; i < 10; i++) {
-                        printf(" %.2f", output[i]);
-                    }
-                    printf(")\n");
-                }
-            */
+        for (int i = 0; i < 10; i++) {
+            fann_set_precision(ann[i], INFERENCE_PRECISION);
         }
 
-        printf("Guessed %d correctly and %d incorrectly out of %d. Performance: %.2f %%\n", correct_guesses, incorrect_guesses, correct_guesses + incorrect_guesses, 100.0 * (float) correct_guesses / (float)(correct_guesses + incorrect_guesses));
+        int held_out_count = test_count - CALIBRATION_SIZE;
+        printf("Accuracy on %d held out test pairs (%s / FANN_PRECISION_INT8):\n", held_out_count, FANN_PRECISION_NAMES[INFERENCE_PRECISION]);
+        for (int i = 0; i < 10; i++) {
+            printf("Network %d: %.3f %% / %.3f %%\n", i, 100.0 * performance[0][i], 100.0 * performance[1][i]);
+        }
+        printf("All models together: %.2f %% / %.2f %% in %.3f s / %.3f s\n", 100.0 * correct_guesses / held_out_count, 100.0 * quantized_correct_guesses / held_out_count, seconds, quantized_seconds);
+    }
 
+    // Uses the same split as the quantization: the first CALIBRATION_SIZE test pairs learn the order and threshold, the rest measure them
+    if (EARLY_EXIT_ENSEMBLE && test_labels->dimensions[0] <= CALIBRATION_SIZE) {
+        printf("Skipping the early exit ensemble, it needs more than %d test pairs.\n", CALIBRATION_SIZE);
+    } else if (EARLY_EXIT_ENSEMBLE) {
+        int test_count = test_labels->dimensions[0];
+        int held_out_count = test_count - CALIBRATION_SIZE;
+        int order[10];
+        fann_type threshold = calibrate_early_exit(ann, test_images, pixel_map, pixel_count, 0, CALIBRATION_SIZE, order);
+
+        printf("Early exit order:");
+        for (int i = 0; i < 10; i++) {
+            printf(" %d", order[i]);
+        }
+        printf(", threshold: %.4f\n", threshold);
+
+        clock_t start = clock();
+        int correct_guesses = evaluate_ensemble(ann, test_images, test_labels, pixel_map, pixel_count, CALIBRATION_SIZE, test_count);
+        double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+        int image_size = image_width * image_height;
+        fann_type * input = calloc(pixel_count, sizeof(fann_type));
+        int early_correct_guesses = 0;
+        int evaluated_count = 0;
+        start = clock();
+        for (int pair_id = CALIBRATION_SIZE; pair_id < test_count; pair_id++) {
+            for (int i = 0; i < pixel_count; i++) {
+                input[i] = (double) test_images->data[pair_id * image_size + pixel_map[i]] / 255.0;
+            }
+            if (predict_early_exit(ann, input, order, threshold, &evaluated_count) == test_labels->data[pair_id]) {
+                early_correct_guesses++;
+            }
+        }
+        double early_seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
         free(input);
-        free(output);
-    }
 
+        printf("All models together on %d held out test pairs: %.2f %% in %.3f s\n", held_out_count, 100.0 * correct_guesses / held_out_count, seconds);
+        printf("Early exit: %.2f %% (%+.2f %%) in %.3f s, %.2f networks evaluated per pair on average\n", 100.0 * early_correct_guesses / held_out_count, 100.0 * (early_correct_guesses - correct_guesses) / held_out_count, early_seconds, (float) evaluated_count / held_out_count);
+    }
 
     if (SAVE_NETWORKS) {
         printf("Saving networks.\n");
@@ -528,14 +1213,28 @@ int main(int argn, char ** argv) {
             snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d.txt", i, variant);
             fann_save(ann[i], buffer);
         }
+        if (BINARY_NETWORKS && !save_network_bundle(ann, variant, image_width, image_height, pixel_map, pixel_count)) {
+            printf("Error: could not save the network bundle\n");
+        }
+    }
+
+    // The run is complete, the next one starts from scratch
+    if (CHECKPOINTS) {
+        for (int i = 0; i < 10; i++) {
+            char buffer[256];
+            snprintf(buffer, sizeof(buffer) - 1, "./output/%d-detecting-network-v%d-checkpoint.txt", i, variant);
+            remove(buffer);
+        }
     }
 
     destroy_idx_data(test_images);
     destroy_idx_data(test_labels);
+    free(pixel_map);
 
     printf("Freeing memory\n");
     for (int i = 0; i < 10; i++) {
         fann_destroy_train(train_data[i]);
+        fann_destroy_train(validation_data[i]);
         fann_destroy_train(test_data[i]);
         fann_destroy(ann[i]);
     }